@@ -10,6 +10,7 @@
 
 #include "Common.hpp"
 #include "Array.hpp"
+#include "ArrayView.hpp"
 
 /******************************************************************************
 ** Method:		Constructor.
@@ -17,25 +18,70 @@
 ** Description:	.
 **
 ** Parameters:	nItemSize	The size of an item.
+**				eGrowth		The policy used to grow the buffer.
+**				nGrowBy		The step size for the fixed growth policy.
 **
 ** Returns:		Nothing.
 **
 *******************************************************************************
 */
 
-CArray::CArray(size_t nItemSize)
+CArray::CArray(size_t nItemSize, GrowthPolicy eGrowth, size_t nGrowBy)
 	: m_pData(NULL)
 	, m_nSize(0)
 	, m_nAllocSize(0)
 	, m_nItemSize(nItemSize)
+	, m_eGrowth(eGrowth)
+	, m_nGrowBy(nGrowBy)
+	, m_pInline(NULL)
+	, m_nInlineSize(0)
+	, m_pAllocator(NULL)
+	, m_pfnRelocate(NULL)
+	, m_pRefCount(NULL)
 {
 	ASSERT(m_nItemSize > 0);
+	ASSERT(m_nGrowBy > 0);
+}
+
+/******************************************************************************
+** Method:		Constructor.
+**
+** Description:	Constructs the array using a fixed size buffer, owned by the
+**				derived class, for the first items. The buffer is only moved to
+**				the heap when the array grows beyond it.
+**
+** Parameters:	nItemSize	The size of an item.
+**				pInline		The inline buffer.
+**				nInlineSize	The number of items the inline buffer can hold.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CArray::CArray(size_t nItemSize, void* pInline, size_t nInlineSize)
+	: m_pData(static_cast<byte*>(pInline))
+	, m_nSize(0)
+	, m_nAllocSize(nInlineSize)
+	, m_nItemSize(nItemSize)
+	, m_eGrowth(GROW_GEOMETRIC)
+	, m_nGrowBy(DEF_GROW_BY)
+	, m_pInline(static_cast<byte*>(pInline))
+	, m_nInlineSize(nInlineSize)
+	, m_pAllocator(NULL)
+	, m_pfnRelocate(NULL)
+	, m_pRefCount(NULL)
+{
+	ASSERT(m_nItemSize > 0);
+	ASSERT(m_pInline != NULL);
+	ASSERT(m_nInlineSize > 0);
 }
 
 /******************************************************************************
 ** Method:		Copy constructor.
 **
-** Description:	Copies the other array.
+** Description:	Copies the other array. The buffer is shared with the other
+**				array until one of them is modified.
 **
 ** Parameters:	.
 **
@@ -46,22 +92,18 @@ CArray::CArray(size_t nItemSize)
 
 CArray::CArray(const CArray& rArray)
 	: m_pData(NULL)
-	, m_nSize(rArray.m_nSize)
-	, m_nAllocSize(rArray.m_nAllocSize)
+	, m_nSize(0)
+	, m_nAllocSize(0)
 	, m_nItemSize(rArray.m_nItemSize)
+	, m_eGrowth(rArray.m_eGrowth)
+	, m_nGrowBy(rArray.m_nGrowBy)
+	, m_pInline(NULL)
+	, m_nInlineSize(0)
+	, m_pAllocator(rArray.m_pAllocator)
+	, m_pfnRelocate(rArray.m_pfnRelocate)
+	, m_pRefCount(NULL)
 {
-	// Array not empty?
-	if (rArray.m_pData != NULL)
-	{
-		// Calculate number of bytes to allocate.
-		size_t nBytes = m_nAllocSize * m_nItemSize;
-
-		// Allocate the array.
-		m_pData = static_cast<byte*>(realloc(m_pData, nBytes));
-
-		// Copy the data.
-		memcpy(m_pData, rArray.m_pData, nBytes);
-	}
+	Share(rArray);
 }
 
 /******************************************************************************
@@ -81,6 +123,140 @@ CArray::~CArray()
 	RemoveAll();
 }
 
+/******************************************************************************
+** Method:		Share()
+**
+** Description:	Share the buffer of another array, which must contain items
+**				that can be copied bytewise. The buffer is reference counted
+**				and copied on the first modification of either array.
+**				NB: An inline buffer cannot be shared and so is copied. The
+**				counter is created by the first copy, which may race with
+**				other copies of the same array.
+**
+** Parameters:	rArray		The array to share.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CArray::Share(const CArray& rArray)
+{
+	ASSERT(m_nSize == 0);
+	ASSERT(m_nItemSize == rArray.m_nItemSize);
+	ASSERT(rArray.m_pfnRelocate == NULL);
+
+	// Nothing to share?
+	if (rArray.m_nSize == 0)
+		return;
+
+	// Can't share an inline buffer?
+	if (rArray.IsInline())
+	{
+		InsertRange(0, rArray.m_pData, rArray.m_nSize);
+		return;
+	}
+
+	RemoveAll();
+
+	void* volatile* ppRefCount = reinterpret_cast<void* volatile*>(&rArray.m_pRefCount);
+
+	// Read with a barrier so that another thread's counter is seen.
+	LONG* pRefCount = static_cast<LONG*>(::InterlockedCompareExchangePointer(ppRefCount, NULL, NULL));
+
+	// First copy of the buffer?
+	if (pRefCount == NULL)
+	{
+		LONG* pNewRefCount = new LONG(1);
+
+		pRefCount = static_cast<LONG*>(::InterlockedCompareExchangePointer(ppRefCount, pNewRefCount, NULL));
+
+		// Lost the race with another copy?
+		if (pRefCount != NULL)
+			delete pNewRefCount;
+		else
+			pRefCount = pNewRefCount;
+	}
+
+	::InterlockedIncrement(pRefCount);
+
+	m_pData      = rArray.m_pData;
+	m_nSize      = rArray.m_nSize;
+	m_nAllocSize = rArray.m_nAllocSize;
+	m_pAllocator = rArray.m_pAllocator;
+	m_pRefCount  = pRefCount;
+}
+
+/******************************************************************************
+** Method:		UnshareBuffer()
+**
+** Description:	Copy the shared buffer so that it can be modified.
+**
+** Parameters:	nAllocSize	The number of items to allocate space for.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CArray::UnshareBuffer(size_t nAllocSize)
+{
+	ASSERT(m_pRefCount != NULL);
+	ASSERT(nAllocSize >= m_nSize);
+
+	// Only reference left?
+	if (*m_pRefCount == 1)
+	{
+		delete m_pRefCount;
+		m_pRefCount = NULL;
+
+		if (nAllocSize != m_nAllocSize)
+			Reallocate(nAllocSize);
+
+		return;
+	}
+
+	byte* pData = ResizeBuffer(NULL, 0, nAllocSize * m_nItemSize);
+	ASSERT(pData);
+
+	memcpy(pData, m_pData, m_nSize * m_nItemSize);
+
+	ReleaseBuffer();
+
+	m_pData      = pData;
+	m_nAllocSize = nAllocSize;
+}
+
+/******************************************************************************
+** Method:		ReleaseBuffer()
+**
+** Description:	Release our reference to the buffer, freeing it if this was the
+**				last one.
+**
+** Parameters:	None.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CArray::ReleaseBuffer()
+{
+	// Buffer still shared?
+	if ( (m_pRefCount != NULL) && (::InterlockedDecrement(m_pRefCount) != 0) )
+	{
+		m_pRefCount = NULL;
+		return;
+	}
+
+	delete m_pRefCount;
+	m_pRefCount = NULL;
+
+	// Free the array buffer.
+	if ( (m_pData != NULL) && (!IsInline()) )
+		FreeBuffer(m_pData, m_nAllocSize * m_nItemSize);
+}
+
 /******************************************************************************
 ** Method:		Reserve()
 **
@@ -100,14 +276,288 @@ void CArray::Reserve(size_t nSize)
 		return;
 
 	// Round size to a multiple of 4.
-	m_nAllocSize = (nSize + 3) & ~3;
+	Reallocate((nSize + 3) & ~3);
+}
+
+/******************************************************************************
+** Method:		ShrinkToFit()
+**
+** Description:	Release any unused space at the end of the buffer.
+**
+** Parameters:	None.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CArray::ShrinkToFit()
+{
+	// Buffer already the right size?
+	if (m_nAllocSize == m_nSize)
+		return;
+
+	// Array empty?
+	if (m_nSize == 0)
+	{
+		RemoveAll();
+		return;
+	}
+
+	Reallocate(m_nSize);
+}
+
+/******************************************************************************
+** Method:		SetGrowthPolicy()
+**
+** Description:	Sets the policy used when the buffer needs to grow.
+**
+** Parameters:	eGrowth		The growth policy.
+**				nGrowBy		The step size for the fixed growth policy.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CArray::SetGrowthPolicy(GrowthPolicy eGrowth, size_t nGrowBy)
+{
+	ASSERT(nGrowBy > 0);
+
+	m_eGrowth = eGrowth;
+	m_nGrowBy = nGrowBy;
+}
+
+/******************************************************************************
+** Method:		SetAllocator()
+**
+** Description:	Sets the allocator used for the buffer. Any existing buffer is
+**				moved to one from the new allocator.
+**
+** Parameters:	pAllocator	The allocator or NULL to use the CRT heap.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CArray::SetAllocator(CArrayAllocator* pAllocator)
+{
+	// Allocator unchanged?
+	if (pAllocator == m_pAllocator)
+		return;
+
+	Unshare();
+
+	// Buffer on the heap?
+	if ( (m_pData != NULL) && (!IsInline()) )
+	{
+		size_t nBytes = m_nAllocSize * m_nItemSize;
+		byte*  pData  = static_cast<byte*>((pAllocator != NULL) ? pAllocator->Allocate(nBytes) : malloc(nBytes));
+		ASSERT(pData);
+
+		RelocateItems(pData, m_pData, m_nSize);
+
+		FreeBuffer(m_pData, nBytes);
+
+		m_pData = pData;
+	}
+
+	m_pAllocator = pAllocator;
+}
+
+/******************************************************************************
+** Method:		Grow()
+**
+** Description:	Ensure there is space for at least the number of items
+**				requested, growing the buffer according to the growth policy.
+**				NB: The geometric policy grows by 50% which keeps the cost of
+**				repeated appends amortised O(1).
+**
+** Parameters:	nSize	The number of items required.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CArray::Grow(size_t nSize)
+{
+	// Buffer already big enough?
+	if (nSize <= m_nAllocSize)
+		return;
+
+	size_t nAllocSize = nSize;
+
+	switch (m_eGrowth)
+	{
+		case GROW_GEOMETRIC:
+		{
+			size_t nGeometric = m_nAllocSize + (m_nAllocSize / 2);
+
+			if (nGeometric > nAllocSize)
+				nAllocSize = nGeometric;
+
+			// Round size to a multiple of 4.
+			nAllocSize = (nAllocSize + 3) & ~3;
+		}
+		break;
+
+		case GROW_FIXED:
+		{
+			// Round size to a multiple of the step.
+			nAllocSize = ((nSize + m_nGrowBy - 1) / m_nGrowBy) * m_nGrowBy;
+		}
+		break;
+
+		case GROW_EXACT:
+		{
+			nAllocSize = nSize;
+		}
+		break;
+
+		default:
+		{
+			ASSERT_FALSE();
+		}
+		break;
+	}
+
+	Reallocate(nAllocSize);
+}
+
+/******************************************************************************
+** Method:		Reallocate()
+**
+** Description:	Resize the buffer to hold exactly the number of items given.
+**				The inline buffer, if there is one, is used whenever the items
+**				will fit.
+**
+** Parameters:	nAllocSize	The number of items to allocate space for.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CArray::Reallocate(size_t nAllocSize)
+{
+	ASSERT(nAllocSize >= m_nSize);
+	ASSERT(nAllocSize > 0);
+
+	// Buffer shared with another array?
+	if (m_pRefCount != NULL)
+	{
+		UnshareBuffer(nAllocSize);
+		return;
+	}
+
+	// Fits in the inline buffer?
+	if (nAllocSize <= m_nInlineSize)
+	{
+		// Move back from the heap?
+		if (!IsInline())
+		{
+			RelocateItems(m_pInline, m_pData, m_nSize);
+			FreeBuffer(m_pData, m_nAllocSize * m_nItemSize);
+
+			m_pData = m_pInline;
+		}
+
+		m_nAllocSize = m_nInlineSize;
+		return;
+	}
 
 	// Calculate number of bytes to allocate.
-	size_t nBytes = m_nAllocSize * m_nItemSize;
+	size_t nBytes = nAllocSize * m_nItemSize;
+
+	// Moving out of the inline buffer or items can't be moved bytewise?
+	if ( (IsInline()) || ((m_pfnRelocate != NULL) && (m_pData != NULL)) )
+	{
+		byte* pData = ResizeBuffer(NULL, 0, nBytes);
+		ASSERT(pData);
+
+		RelocateItems(pData, m_pData, m_nSize);
+
+		if (!IsInline())
+			FreeBuffer(m_pData, m_nAllocSize * m_nItemSize);
 
-	// Allocate it...
-	m_pData = static_cast<byte*>(realloc(m_pData, nBytes));
-	ASSERT(m_pData);
+		m_pData = pData;
+	}
+	else
+	{
+		// Allocate it...
+		m_pData = ResizeBuffer(m_pData, m_nAllocSize * m_nItemSize, nBytes);
+		ASSERT(m_pData);
+	}
+
+	m_nAllocSize = nAllocSize;
+}
+
+/******************************************************************************
+** Method:		ResizeBuffer()
+**
+** Description:	Resize a heap buffer using the array's allocator.
+**
+** Parameters:	pBuffer		The buffer or NULL.
+**				nOldBytes	The current buffer size.
+**				nNewBytes	The required buffer size.
+**
+** Returns:		The resized buffer.
+**
+*******************************************************************************
+*/
+
+byte* CArray::ResizeBuffer(byte* pBuffer, size_t nOldBytes, size_t nNewBytes)
+{
+	if (m_pAllocator == NULL)
+		return static_cast<byte*>(realloc(pBuffer, nNewBytes));
+
+	return static_cast<byte*>(m_pAllocator->Reallocate(pBuffer, nOldBytes, nNewBytes));
+}
+
+/******************************************************************************
+** Method:		FreeBuffer()
+**
+** Description:	Free a heap buffer using the array's allocator.
+**
+** Parameters:	pBuffer		The buffer.
+**				nBytes		The buffer size.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CArray::FreeBuffer(byte* pBuffer, size_t nBytes)
+{
+	if (m_pAllocator == NULL)
+		free(pBuffer);
+	else
+		m_pAllocator->Free(pBuffer, nBytes);
+}
+
+/******************************************************************************
+** Method:		RelocateItems()
+**
+** Description:	Move items to an uninitialised buffer. Items are moved bytewise
+**				unless the derived class has supplied a relocate callback.
+**
+** Parameters:	pDst	The destination buffer.
+**				pSrc	The items to move.
+**				nCount	The number of items.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CArray::RelocateItems(byte* pDst, byte* pSrc, size_t nCount)
+{
+	if (m_pfnRelocate == NULL)
+		memcpy(pDst, pSrc, nCount * m_nItemSize);
+	else
+		m_pfnRelocate(pDst, pSrc, nCount);
 }
 
 /******************************************************************************
@@ -127,6 +577,8 @@ void CArray::Set(size_t nIndex, const void* pItem)
 {
 	ASSERT(nIndex <= m_nSize);
 
+	Unshare();
+
 	// Calculate offset to the position.
 	byte* pPos = m_pData + (nIndex * m_nItemSize);
 
@@ -148,8 +600,10 @@ void CArray::Set(size_t nIndex, const void* pItem)
 
 size_t CArray::Add(const void* pItem)
 {
+	Unshare();
+
 	// Increase buffer by 1.
-	Reserve(m_nSize+1);
+	Grow(m_nSize+1);
 
 	// Calculate offset of end of array.
 	byte* pPos = m_pData + (m_nSize * m_nItemSize);
@@ -177,8 +631,10 @@ void CArray::Insert(size_t nIndex, const void* pItem)
 {
 	ASSERT(nIndex <= m_nSize);
 
+	Unshare();
+
 	// Increase buffer by 1.
-	Reserve(m_nSize+1);
+	Grow(m_nSize+1);
 
 	// Calculate offset to insert position.
 	byte* pPos = m_pData + (nIndex * m_nItemSize);
@@ -195,6 +651,87 @@ void CArray::Insert(size_t nIndex, const void* pItem)
 	++m_nSize;
 }
 
+/******************************************************************************
+** Method:		AddRange()
+**
+** Description:	Appends a block of items to the array.
+**
+** Parameters:	pItems	A pointer to the first item to add.
+**				nCount	The number of items to add.
+**
+** Returns:		The position where the first item was added.
+**
+*******************************************************************************
+*/
+
+size_t CArray::AddRange(const void* pItems, size_t nCount)
+{
+	size_t nIndex = m_nSize;
+
+	InsertRange(nIndex, pItems, nCount);
+
+	return nIndex;
+}
+
+/******************************************************************************
+** Method:		InsertRange()
+**
+** Description:	Inserts a block of items into the array. The buffer is grown
+**				once and the existing items are moved up in a single block.
+**
+** Parameters:	nIndex	The index where to insert at.
+**				pItems	A pointer to the first item to insert.
+**				nCount	The number of items to insert.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CArray::InsertRange(size_t nIndex, const void* pItems, size_t nCount)
+{
+	ASSERT(nIndex <= m_nSize);
+	ASSERT((pItems != NULL) || (nCount == 0));
+
+	// Nothing to insert?
+	if (nCount == 0)
+		return;
+
+	Unshare();
+
+	const byte* pSrc   = static_cast<const byte*>(pItems);
+	size_t      nBytes = nCount * m_nItemSize;
+
+	// Inserting items from our own buffer?
+	if ( (pSrc >= m_pData) && (pSrc < (m_pData + (m_nAllocSize * m_nItemSize))) )
+	{
+		// Take a copy as growing the buffer will invalidate them.
+		byte* pCopy = static_cast<byte*>(malloc(nBytes));
+		ASSERT(pCopy);
+
+		memcpy(pCopy, pSrc, nBytes);
+
+		InsertRange(nIndex, pCopy, nCount);
+
+		free(pCopy);
+		return;
+	}
+
+	// Increase buffer by the number of items.
+	Grow(m_nSize+nCount);
+
+	// Calculate offset to insert position.
+	byte* pPos = m_pData + (nIndex * m_nItemSize);
+
+	// Move all existing items up in one block.
+	memmove(pPos + nBytes, pPos, (m_nSize - nIndex) * m_nItemSize);
+
+	// Copy the new items into the array.
+	memcpy(pPos, pSrc, nBytes);
+
+	m_nSize += nCount;
+}
+
 /******************************************************************************
 ** Method:		Remove()
 **
@@ -211,6 +748,8 @@ void CArray::Remove(size_t nIndex)
 {
 	ASSERT(nIndex < m_nSize);
 
+	Unshare();
+
 	// Calculate offset to the item.
 	byte* pPos = m_pData + (nIndex * m_nItemSize);
 
@@ -223,6 +762,43 @@ void CArray::Remove(size_t nIndex)
 	m_nSize--;
 }
 
+/******************************************************************************
+** Method:		RemoveRange()
+**
+** Description:	Removes a block of items from the array. The remaining items
+**				are moved down in a single block.
+**
+** Parameters:	nIndex	The index of the first item to remove.
+**				nCount	The number of items to remove.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CArray::RemoveRange(size_t nIndex, size_t nCount)
+{
+	ASSERT(nIndex <= m_nSize);
+	ASSERT(nCount <= (m_nSize - nIndex));
+
+	// Nothing to remove?
+	if (nCount == 0)
+		return;
+
+	Unshare();
+
+	// Calculate offset to the first item.
+	byte* pPos = m_pData + (nIndex * m_nItemSize);
+
+	// Calculate the size of bytes to move down.
+	size_t nBytes = (m_nSize - nIndex - nCount) * m_nItemSize;
+
+	// Move all following items down in one block.
+	memmove(pPos, pPos + (nCount * m_nItemSize), nBytes);
+
+	m_nSize -= nCount;
+}
+
 /******************************************************************************
 ** Method:		RemoveAll()
 **
@@ -237,16 +813,101 @@ void CArray::Remove(size_t nIndex)
 
 void CArray::RemoveAll()
 {
-	// Free the array buffer.
-	if (m_pData != NULL)
+	// Free the array buffer, unless shared.
+	ReleaseBuffer();
+
+	// Revert to the inline buffer, if one.
+	m_pData = m_pInline;
+
+	// Reset size members.
+	m_nSize      = 0;
+	m_nAllocSize = m_nInlineSize;
+}
+
+/******************************************************************************
+** Method:		Attach()
+**
+** Description:	Take ownership of a buffer of items, freeing the current one.
+**				NB: The buffer must have been allocated by the array's
+**				allocator, i.e. with malloc() or realloc() if it has none.
+**
+** Parameters:	pData		The buffer or NULL.
+**				nSize		The number of items in the buffer.
+**				nAllocSize	The number of items the buffer can hold.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CArray::Attach(byte* pData, size_t nSize, size_t nAllocSize)
+{
+	ASSERT(nSize <= nAllocSize);
+	ASSERT((pData != NULL) || (nAllocSize == 0));
+
+	RemoveAll();
+
+	if (pData == NULL)
+		return;
+
+	m_pData      = pData;
+	m_nSize      = nSize;
+	m_nAllocSize = nAllocSize;
+}
+
+/******************************************************************************
+** Method:		Detach()
+**
+** Description:	Give up ownership of the buffer to the caller, which must free
+**				it with the array's allocator. The array is left empty.
+**				NB: A shared or inline buffer is copied first.
+**
+** Parameters:	nSize		The number of items in the buffer.
+**				nAllocSize	The number of items the buffer can hold.
+**
+** Returns:		The buffer or NULL if the array is empty.
+**
+*******************************************************************************
+*/
+
+byte* CArray::Detach(size_t& nSize, size_t& nAllocSize)
+{
+	nSize      = 0;
+	nAllocSize = 0;
+
+	if (m_nSize == 0)
 	{
-		free(m_pData);
-		m_pData = NULL;
+		RemoveAll();
+		return NULL;
 	}
 
-	// Reset size members.
+	// Buffer shared with another array?
+	if (m_pRefCount != NULL)
+		UnshareBuffer(m_nAllocSize);
+
+	// Buffer owned by the derived class?
+	if (IsInline())
+	{
+		byte* pData = ResizeBuffer(NULL, 0, m_nSize * m_nItemSize);
+		ASSERT(pData);
+
+		RelocateItems(pData, m_pData, m_nSize);
+
+		m_pData      = pData;
+		m_nAllocSize = m_nSize;
+	}
+
+	byte* pData = m_pData;
+
+	nSize      = m_nSize;
+	nAllocSize = m_nAllocSize;
+
+	// Revert to the inline buffer, if one.
+	m_pData      = m_pInline;
 	m_nSize      = 0;
-	m_nAllocSize = 0;
+	m_nAllocSize = m_nInlineSize;
+
+	return pData;
 }
 
 /******************************************************************************
@@ -263,5 +924,91 @@ void CArray::RemoveAll()
 
 void CArray::Sort(PFNQSCOMPARE pfnCompare)
 {
+	Unshare();
+
 	qsort(m_pData, m_nSize, m_nItemSize, pfnCompare);
 }
+
+/******************************************************************************
+** Method:		Save()
+**
+** Description:	Save the items to a file which can be mapped by a CArrayView.
+**				NB: Only for items which can be copied bytewise.
+**
+** Parameters:	pszPath		The file path.
+**				nTypeTag	A caller defined tag for the item type.
+**
+** Returns:		true or false on failure.
+**
+*******************************************************************************
+*/
+
+bool CArray::Save(const tchar* pszPath, uint nTypeTag) const
+{
+	ASSERT(pszPath != NULL);
+	ASSERT(m_pfnRelocate == NULL);
+
+	HANDLE hFile = ::CreateFile(pszPath, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	size_t             nBytes = m_nSize * m_nItemSize;
+	byte               aHeader[CArrayView::HEADER_SIZE] = { 0 };
+	CArrayView::Header oHeader;
+
+	oHeader.m_dwMagic    = CArrayView::FILE_MAGIC;
+	oHeader.m_dwVersion  = CArrayView::FILE_VERSION;
+	oHeader.m_dwTypeTag  = nTypeTag;
+	oHeader.m_dwItemSize = static_cast<DWORD>(m_nItemSize);
+	oHeader.m_nCount     = m_nSize;
+	oHeader.m_dwChecksum = CArrayView::Checksum(m_pData, nBytes);
+	oHeader.m_dwReserved = 0;
+
+	memcpy(aHeader, &oHeader, sizeof(oHeader));
+
+	bool bSaved = (WriteBuffer(hFile, aHeader, sizeof(aHeader)) && WriteBuffer(hFile, m_pData, nBytes));
+
+	::CloseHandle(hFile);
+
+	// Don't leave a partial file behind.
+	if (!bSaved)
+		::DeleteFile(pszPath);
+
+	return bSaved;
+}
+
+/******************************************************************************
+** Method:		WriteBuffer()
+**
+** Description:	Write a buffer to a file, in chunks small enough for WriteFile().
+**
+** Parameters:	hFile		The file handle.
+**				pBuffer		The buffer.
+**				nBytes		The buffer size.
+**
+** Returns:		true or false on failure.
+**
+*******************************************************************************
+*/
+
+bool CArray::WriteBuffer(HANDLE hFile, const void* pBuffer, size_t nBytes)
+{
+	const size_t MAX_CHUNK = 1024 * 1024 * 1024;
+
+	const byte* pBytes = static_cast<const byte*>(pBuffer);
+
+	while (nBytes != 0)
+	{
+		DWORD dwChunk   = static_cast<DWORD>((nBytes < MAX_CHUNK) ? nBytes : MAX_CHUNK);
+		DWORD dwWritten = 0;
+
+		if ( (!::WriteFile(hFile, pBytes, dwChunk, &dwWritten, NULL)) || (dwWritten != dwChunk) )
+			return false;
+
+		pBytes += dwWritten;
+		nBytes -= dwWritten;
+	}
+
+	return true;
+}
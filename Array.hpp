@@ -16,6 +16,8 @@
 #pragma once
 #endif
 
+#include "ArrayAllocator.hpp"
+
 /******************************************************************************
 **
 ** This is the base class for all array collections.
@@ -26,24 +28,43 @@
 class CArray
 {
 public:
+	// Buffer growth policies.
+	enum GrowthPolicy
+	{
+		GROW_GEOMETRIC,		// Grow by half the current capacity.
+		GROW_FIXED,			// Grow by a fixed number of items.
+		GROW_EXACT			// Grow to the exact size required.
+	};
+
+	// Default fixed growth step.
+	enum { DEF_GROW_BY = 4 };
+
 	//
 	// Attributes.
 	//
 	size_t Size() const;
+	size_t Capacity() const;
 
 	//
 	// Memory methods.
 	//
 	virtual void Reserve(size_t nSize);
+	void ShrinkToFit();
+	void SetGrowthPolicy(GrowthPolicy eGrowth, size_t nGrowBy = DEF_GROW_BY);
+	void SetAllocator(CArrayAllocator* pAllocator);
 
 protected:
 	// Sort callback function.
 	typedef int (*PFNQSCOMPARE)(const void* pItem1, const void* pItem2);
 
+	// Callback function to move items which cannot be moved bytewise.
+	typedef void (*PFNRELOCATE)(void* pDst, void* pSrc, size_t nCount);
+
 	//
 	// Constructors/Destructor.
 	//
-	CArray(size_t nItemSize);
+	explicit CArray(size_t nItemSize, GrowthPolicy eGrowth = GROW_GEOMETRIC, size_t nGrowBy = DEF_GROW_BY);
+	CArray(size_t nItemSize, void* pInline, size_t nInlineSize);
 	CArray(const CArray& rArray);
 	virtual ~CArray();
 
@@ -54,21 +75,49 @@ protected:
 	size_t	m_nSize;
 	size_t	m_nAllocSize;
 	size_t	m_nItemSize;
+	GrowthPolicy	m_eGrowth;
+	size_t	m_nGrowBy;
+	byte*	m_pInline;
+	size_t	m_nInlineSize;
+	CArrayAllocator*	m_pAllocator;
+	PFNRELOCATE	m_pfnRelocate;
+	mutable LONG*	m_pRefCount;
 
 	//
 	// Internal Methods.
 	//
+	bool IsInline() const;
+	void Grow(size_t nSize);
+	void Reallocate(size_t nAllocSize);
+	byte* ResizeBuffer(byte* pBuffer, size_t nOldBytes, size_t nNewBytes);
+	void FreeBuffer(byte* pBuffer, size_t nBytes);
+	void RelocateItems(byte* pDst, byte* pSrc, size_t nCount);
+
+	void Share(const CArray& rArray);
+	void Unshare();
+	void UnshareBuffer(size_t nAllocSize);
+	void ReleaseBuffer();
+
 	void* At(size_t nIndex) const;
 	void* operator[](size_t nIndex) const;
 
 	void Set(size_t nIndex, const void* pItem);
 	size_t Add(const void* pItem);
 	void Insert(size_t nIndex, const void* pItem);
+	size_t AddRange(const void* pItems, size_t nCount);
+	void InsertRange(size_t nIndex, const void* pItems, size_t nCount);
 	void Remove(size_t nIndex);
+	void RemoveRange(size_t nIndex, size_t nCount);
 	void RemoveAll();
 
+	void Attach(byte* pData, size_t nSize, size_t nAllocSize);
+	byte* Detach(size_t& nSize, size_t& nAllocSize);
+
 	void Sort(PFNQSCOMPARE pfnCompare);
 
+	bool Save(const tchar* pszPath, uint nTypeTag) const;
+	static bool WriteBuffer(HANDLE hFile, const void* pBuffer, size_t nBytes);
+
 private:
 	// NotCopyable.
 	CArray& operator=(const CArray&);
@@ -86,6 +135,23 @@ inline size_t CArray::Size() const
 	return m_nSize;
 }
 
+inline size_t CArray::Capacity() const
+{
+	return m_nAllocSize;
+}
+
+inline bool CArray::IsInline() const
+{
+	return ((m_pInline != NULL) && (m_pData == m_pInline));
+}
+
+inline void CArray::Unshare()
+{
+	// Buffer shared with another array?
+	if (m_pRefCount != NULL)
+		UnshareBuffer(m_nAllocSize);
+}
+
 inline void* CArray::At(size_t nIndex) const
 {
 	ASSERT(nIndex < m_nSize);
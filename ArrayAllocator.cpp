@@ -0,0 +1,727 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		ARRAYALLOCATOR.CPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	CArrayAllocator class definitions.
+**
+*******************************************************************************
+*/
+
+#include "Common.hpp"
+#include "ArrayAllocator.hpp"
+#include <malloc.h>
+#include <algorithm>
+
+/******************************************************************************
+** Method:		Constructor.
+**
+** Description:	.
+**
+** Parameters:	None.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CArrayAllocator::CArrayAllocator()
+{
+}
+
+/******************************************************************************
+** Method:		Destructor.
+**
+** Description:	.
+**
+** Parameters:	None.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CArrayAllocator::~CArrayAllocator()
+{
+}
+
+/******************************************************************************
+** Method:		Constructor.
+**
+** Description:	.
+**
+** Parameters:	nAlignment	The buffer alignment, which must be a power of 2.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CAlignedAllocator::CAlignedAllocator(size_t nAlignment)
+	: m_nAlignment(nAlignment)
+{
+	ASSERT((m_nAlignment != 0) && ((m_nAlignment & (m_nAlignment-1)) == 0));
+}
+
+/******************************************************************************
+** Method:		Destructor.
+**
+** Description:	.
+**
+** Parameters:	None.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CAlignedAllocator::~CAlignedAllocator()
+{
+}
+
+/******************************************************************************
+** Method:		Reallocate()
+**
+** Description:	Resize an aligned buffer.
+**
+** Parameters:	pBuffer		The buffer or NULL.
+**				nOldBytes	The current buffer size.
+**				nNewBytes	The required buffer size.
+**
+** Returns:		The resized buffer.
+**
+*******************************************************************************
+*/
+
+void* CAlignedAllocator::Reallocate(void* pBuffer, size_t /*nOldBytes*/, size_t nNewBytes)
+{
+	return _aligned_realloc(pBuffer, nNewBytes, m_nAlignment);
+}
+
+/******************************************************************************
+** Method:		Free()
+**
+** Description:	Free an aligned buffer.
+**
+** Parameters:	pBuffer		The buffer.
+**				nBytes		The buffer size.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CAlignedAllocator::Free(void* pBuffer, size_t /*nBytes*/)
+{
+	_aligned_free(pBuffer);
+}
+
+/******************************************************************************
+** Method:		Constructor.
+**
+** Description:	.
+**
+** Parameters:	nChunkSize	The default size of each chunk.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CArenaAllocator::CArenaAllocator(size_t nChunkSize)
+	: m_nChunkSize(Align(nChunkSize))
+	, m_vChunks()
+	, m_pNext(NULL)
+	, m_pEnd(NULL)
+	, m_pLast(NULL)
+{
+	ASSERT(m_nChunkSize > 0);
+}
+
+/******************************************************************************
+** Method:		Destructor.
+**
+** Description:	Frees all the chunks.
+**
+** Parameters:	None.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CArenaAllocator::~CArenaAllocator()
+{
+	Reset();
+}
+
+/******************************************************************************
+** Method:		Reallocate()
+**
+** Description:	Resize a buffer. The most recent buffer is resized in place if
+**				there is room in the chunk, otherwise a new buffer is carved
+**				out and the contents copied.
+**
+** Parameters:	pBuffer		The buffer or NULL.
+**				nOldBytes	The current buffer size.
+**				nNewBytes	The required buffer size.
+**
+** Returns:		The resized buffer.
+**
+*******************************************************************************
+*/
+
+void* CArenaAllocator::Reallocate(void* pBuffer, size_t nOldBytes, size_t nNewBytes)
+{
+	size_t nBytes = Align(nNewBytes);
+
+	// Most recent buffer and room to resize in place?
+	if ( (pBuffer != NULL) && (pBuffer == m_pLast)
+	  && (nBytes <= static_cast<size_t>(m_pEnd - m_pLast)) )
+	{
+		m_pNext = m_pLast + nBytes;
+
+		return pBuffer;
+	}
+
+	// Current chunk full?
+	if ( (m_pNext == NULL) || (nBytes > static_cast<size_t>(m_pEnd - m_pNext)) )
+	{
+		size_t nChunkSize = std::max(nBytes, m_nChunkSize);
+		byte*  pChunk     = static_cast<byte*>(_aligned_malloc(nChunkSize, ALIGNMENT));
+
+		if (pChunk == NULL)
+			return NULL;
+
+		m_vChunks.push_back(pChunk);
+
+		m_pNext = pChunk;
+		m_pEnd  = pChunk + nChunkSize;
+	}
+
+	byte* pNewBuffer = m_pNext;
+
+	m_pNext += nBytes;
+	m_pLast  = pNewBuffer;
+
+	// Copy the old contents.
+	if (pBuffer != NULL)
+		memcpy(pNewBuffer, pBuffer, std::min(nOldBytes, nNewBytes));
+
+	return pNewBuffer;
+}
+
+/******************************************************************************
+** Method:		Free()
+**
+** Description:	Free a buffer. Only the most recent buffer is reclaimed, all
+**				others are freed when the arena is reset.
+**
+** Parameters:	pBuffer		The buffer.
+**				nBytes		The buffer size.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CArenaAllocator::Free(void* pBuffer, size_t /*nBytes*/)
+{
+	if ( (pBuffer != NULL) && (pBuffer == m_pLast) )
+	{
+		m_pNext = m_pLast;
+		m_pLast = NULL;
+	}
+}
+
+/******************************************************************************
+** Method:		Reset()
+**
+** Description:	Free all the chunks. Any buffers still in use are invalidated.
+**
+** Parameters:	None.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CArenaAllocator::Reset()
+{
+	for (Chunks::iterator it = m_vChunks.begin(); it != m_vChunks.end(); ++it)
+		_aligned_free(*it);
+
+	m_vChunks.clear();
+
+	m_pNext = NULL;
+	m_pEnd  = NULL;
+	m_pLast = NULL;
+}
+
+/******************************************************************************
+** Method:		Align()
+**
+** Description:	Round the size up to a multiple of the buffer alignment.
+**
+** Parameters:	nBytes	The size to round.
+**
+** Returns:		The rounded size.
+**
+*******************************************************************************
+*/
+
+size_t CArenaAllocator::Align(size_t nBytes)
+{
+	return (nBytes + ALIGNMENT - 1) & ~static_cast<size_t>(ALIGNMENT - 1);
+}
+
+/******************************************************************************
+** Method:		Constructor.
+**
+** Description:	.
+**
+** Parameters:	None.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CPoolAllocator::CPoolAllocator()
+{
+	for (size_t i = 0; i != NUM_CLASSES; ++i)
+		m_apFree[i] = NULL;
+}
+
+/******************************************************************************
+** Method:		Destructor.
+**
+** Description:	Frees all the pooled buffers.
+**
+** Parameters:	None.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CPoolAllocator::~CPoolAllocator()
+{
+	Purge();
+}
+
+/******************************************************************************
+** Method:		Reallocate()
+**
+** Description:	Resize a buffer. If the new size is in the same size class the
+**				buffer is returned as is, otherwise one is taken from the pool
+**				for the new size class and the contents copied.
+**
+** Parameters:	pBuffer		The buffer or NULL.
+**				nOldBytes	The current buffer size.
+**				nNewBytes	The required buffer size.
+**
+** Returns:		The resized buffer.
+**
+*******************************************************************************
+*/
+
+void* CPoolAllocator::Reallocate(void* pBuffer, size_t nOldBytes, size_t nNewBytes)
+{
+	size_t nNewClass = SizeClass(nNewBytes);
+
+	if (pBuffer != NULL)
+	{
+		size_t nOldClass = SizeClass(nOldBytes);
+
+		// Buffer already big enough?
+		if ( (nOldClass == nNewClass) && (nNewClass != NUM_CLASSES) )
+			return pBuffer;
+
+		// Both too big to pool?
+		if ( (nOldClass == NUM_CLASSES) && (nNewClass == NUM_CLASSES) )
+			return realloc(pBuffer, nNewBytes);
+	}
+
+	void* pNewBuffer = NULL;
+
+	// Too big to pool?
+	if (nNewClass == NUM_CLASSES)
+	{
+		pNewBuffer = malloc(nNewBytes);
+	}
+	// Reuse a pooled buffer?
+	else if (m_apFree[nNewClass] != NULL)
+	{
+		FreeBlock* pBlock = m_apFree[nNewClass];
+
+		m_apFree[nNewClass] = pBlock->m_pNext;
+		pNewBuffer = pBlock;
+	}
+	else
+	{
+		pNewBuffer = malloc(static_cast<size_t>(1) << (nNewClass + MIN_SHIFT));
+	}
+
+	if (pNewBuffer == NULL)
+		return NULL;
+
+	// Move the old contents.
+	if (pBuffer != NULL)
+	{
+		memcpy(pNewBuffer, pBuffer, std::min(nOldBytes, nNewBytes));
+		Free(pBuffer, nOldBytes);
+	}
+
+	return pNewBuffer;
+}
+
+/******************************************************************************
+** Method:		Free()
+**
+** Description:	Return a buffer to the pool.
+**
+** Parameters:	pBuffer		The buffer.
+**				nBytes		The buffer size.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CPoolAllocator::Free(void* pBuffer, size_t nBytes)
+{
+	if (pBuffer == NULL)
+		return;
+
+	size_t nClass = SizeClass(nBytes);
+
+	// Too big to pool?
+	if (nClass == NUM_CLASSES)
+	{
+		free(pBuffer);
+		return;
+	}
+
+	FreeBlock* pBlock = static_cast<FreeBlock*>(pBuffer);
+
+	pBlock->m_pNext  = m_apFree[nClass];
+	m_apFree[nClass] = pBlock;
+}
+
+/******************************************************************************
+** Method:		Purge()
+**
+** Description:	Free all the pooled buffers.
+**
+** Parameters:	None.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CPoolAllocator::Purge()
+{
+	for (size_t i = 0; i != NUM_CLASSES; ++i)
+	{
+		while (m_apFree[i] != NULL)
+		{
+			FreeBlock* pBlock = m_apFree[i];
+
+			m_apFree[i] = pBlock->m_pNext;
+			free(pBlock);
+		}
+	}
+}
+
+/******************************************************************************
+** Method:		SizeClass()
+**
+** Description:	Get the size class for a buffer size.
+**
+** Parameters:	nBytes	The buffer size.
+**
+** Returns:		The size class or NUM_CLASSES if too big to pool.
+**
+*******************************************************************************
+*/
+
+size_t CPoolAllocator::SizeClass(size_t nBytes)
+{
+	size_t nClass = 0;
+
+	while ( (nClass != NUM_CLASSES) && (nBytes > (static_cast<size_t>(1) << (nClass + MIN_SHIFT))) )
+		++nClass;
+
+	return nClass;
+}
+
+/******************************************************************************
+** Method:		Constructor.
+**
+** Description:	.
+**
+** Parameters:	nThreshold	The buffer size above which virtual memory is used.
+**				nReserve	The minimum address space to reserve per buffer.
+**				bLargePages	Try to use large pages?
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CVirtualAllocator::CVirtualAllocator(size_t nThreshold, size_t nReserve, bool bLargePages)
+	: m_nThreshold(nThreshold)
+	, m_nReserve(nReserve)
+	, m_nPageSize(0)
+	, m_nLargePageSize(0)
+{
+	SYSTEM_INFO oInfo;
+
+	::GetSystemInfo(&oInfo);
+
+	m_nPageSize = oInfo.dwPageSize;
+
+	if (bLargePages)
+		m_nLargePageSize = ::GetLargePageMinimum();
+}
+
+/******************************************************************************
+** Method:		Destructor.
+**
+** Description:	.
+**
+** Parameters:	None.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CVirtualAllocator::~CVirtualAllocator()
+{
+}
+
+/******************************************************************************
+** Method:		Reallocate()
+**
+** Description:	Resize a buffer. Large buffers are resized in place by
+**				committing or decommitting pages if the reserved address space
+**				allows, otherwise a new buffer is allocated and the contents
+**				copied.
+**
+** Parameters:	pBuffer		The buffer or NULL.
+**				nOldBytes	The current buffer size.
+**				nNewBytes	The required buffer size.
+**
+** Returns:		The resized buffer.
+**
+*******************************************************************************
+*/
+
+void* CVirtualAllocator::Reallocate(void* pBuffer, size_t nOldBytes, size_t nNewBytes)
+{
+	bool bOldLarge = (pBuffer != NULL) && IsLarge(nOldBytes);
+	bool bNewLarge = IsLarge(nNewBytes);
+
+	// Both small enough for the heap?
+	if ( (!bOldLarge) && (!bNewLarge) )
+		return realloc(pBuffer, nNewBytes);
+
+	// Both large and room to resize in place?
+	if ( (bOldLarge) && (bNewLarge) && (ResizeRegion(pBuffer, nNewBytes)) )
+		return pBuffer;
+
+	void* pNewBuffer = (bNewLarge) ? AllocRegion(nNewBytes) : malloc(nNewBytes);
+
+	if (pNewBuffer == NULL)
+		return NULL;
+
+	// Move the old contents.
+	if (pBuffer != NULL)
+	{
+		memcpy(pNewBuffer, pBuffer, std::min(nOldBytes, nNewBytes));
+		Free(pBuffer, nOldBytes);
+	}
+
+	return pNewBuffer;
+}
+
+/******************************************************************************
+** Method:		Free()
+**
+** Description:	Free a buffer. Large buffers are released back to the OS.
+**
+** Parameters:	pBuffer		The buffer.
+**				nBytes		The buffer size.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CVirtualAllocator::Free(void* pBuffer, size_t nBytes)
+{
+	if (pBuffer == NULL)
+		return;
+
+	if (IsLarge(nBytes))
+		::VirtualFree(GetRegion(pBuffer), 0, MEM_RELEASE);
+	else
+		free(pBuffer);
+}
+
+/******************************************************************************
+** Method:		IsLarge()
+**
+** Description:	Query if a buffer of the given size uses virtual memory.
+**
+** Parameters:	nBytes	The buffer size.
+**
+** Returns:		true or false.
+**
+*******************************************************************************
+*/
+
+bool CVirtualAllocator::IsLarge(size_t nBytes) const
+{
+	return (nBytes >= m_nThreshold);
+}
+
+/******************************************************************************
+** Method:		AllocRegion()
+**
+** Description:	Allocate a new region for a large buffer. Large pages are tried
+**				first, if enabled, otherwise the address space is reserved and
+**				only the pages required are committed.
+**
+** Parameters:	nBytes	The buffer size.
+**
+** Returns:		The buffer or NULL on failure.
+**
+*******************************************************************************
+*/
+
+void* CVirtualAllocator::AllocRegion(size_t nBytes)
+{
+	size_t  nCommit = RoundUp(HEADER_SIZE + nBytes, m_nPageSize);
+	Region* pRegion = NULL;
+
+	// Try large pages?
+	if (m_nLargePageSize != 0)
+	{
+		size_t nLarge = RoundUp(HEADER_SIZE + nBytes, m_nLargePageSize);
+
+		pRegion = static_cast<Region*>(::VirtualAlloc(NULL, nLarge, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE));
+
+		if (pRegion != NULL)
+		{
+			pRegion->m_nReserved   = nLarge;
+			pRegion->m_nCommitted  = nLarge;
+			pRegion->m_bLargePages = true;
+		}
+	}
+
+	if (pRegion == NULL)
+	{
+		size_t nReserve = RoundUp(std::max(nCommit * 2, m_nReserve), m_nPageSize);
+
+		pRegion = static_cast<Region*>(::VirtualAlloc(NULL, nReserve, MEM_RESERVE, PAGE_NOACCESS));
+
+		if (pRegion == NULL)
+			return NULL;
+
+		if (::VirtualAlloc(pRegion, nCommit, MEM_COMMIT, PAGE_READWRITE) == NULL)
+		{
+			::VirtualFree(pRegion, 0, MEM_RELEASE);
+			return NULL;
+		}
+
+		pRegion->m_nReserved   = nReserve;
+		pRegion->m_nCommitted  = nCommit;
+		pRegion->m_bLargePages = false;
+	}
+
+	return reinterpret_cast<byte*>(pRegion) + HEADER_SIZE;
+}
+
+/******************************************************************************
+** Method:		ResizeRegion()
+**
+** Description:	Try and resize a large buffer in place by committing more pages
+**				or decommitting those no longer required.
+**
+** Parameters:	pBuffer		The buffer.
+**				nBytes		The required buffer size.
+**
+** Returns:		true if resized, false if the region is too small.
+**
+*******************************************************************************
+*/
+
+bool CVirtualAllocator::ResizeRegion(void* pBuffer, size_t nBytes)
+{
+	Region* pRegion = GetRegion(pBuffer);
+	byte*   pBase   = reinterpret_cast<byte*>(pRegion);
+	size_t  nCommit = RoundUp(HEADER_SIZE + nBytes, m_nPageSize);
+
+	// Not enough address space reserved?
+	if (nCommit > pRegion->m_nReserved)
+		return false;
+
+	// Large pages cannot be committed or decommitted.
+	if (pRegion->m_bLargePages)
+		return true;
+
+	if (nCommit > pRegion->m_nCommitted)
+	{
+		if (::VirtualAlloc(pBase + pRegion->m_nCommitted, nCommit - pRegion->m_nCommitted, MEM_COMMIT, PAGE_READWRITE) == NULL)
+			return false;
+
+		pRegion->m_nCommitted = nCommit;
+	}
+	else if (nCommit < pRegion->m_nCommitted)
+	{
+		::VirtualFree(pBase + nCommit, pRegion->m_nCommitted - nCommit, MEM_DECOMMIT);
+
+		pRegion->m_nCommitted = nCommit;
+	}
+
+	return true;
+}
+
+/******************************************************************************
+** Method:		GetRegion()
+**
+** Description:	Get the region header for a large buffer.
+**
+** Parameters:	pBuffer		The buffer.
+**
+** Returns:		The region header.
+**
+*******************************************************************************
+*/
+
+CVirtualAllocator::Region* CVirtualAllocator::GetRegion(void* pBuffer)
+{
+	return reinterpret_cast<Region*>(static_cast<byte*>(pBuffer) - HEADER_SIZE);
+}
+
+/******************************************************************************
+** Method:		RoundUp()
+**
+** Description:	Round the size up to a multiple of the page size.
+**
+** Parameters:	nBytes		The size to round.
+**				nMultiple	The page size, which must be a power of 2.
+**
+** Returns:		The rounded size.
+**
+*******************************************************************************
+*/
+
+size_t CVirtualAllocator::RoundUp(size_t nBytes, size_t nMultiple)
+{
+	return (nBytes + nMultiple - 1) & ~(nMultiple - 1);
+}
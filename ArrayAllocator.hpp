@@ -0,0 +1,266 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		ARRAYALLOCATOR.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The CArrayAllocator class declarations.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef ARRAYALLOCATOR_HPP
+#define ARRAYALLOCATOR_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include <vector>
+
+/******************************************************************************
+**
+** This is the base class for allocators used to manage an array's buffer.
+** NB: Arrays without an allocator use the CRT heap directly.
+**
+*******************************************************************************
+*/
+
+class CArrayAllocator
+{
+public:
+	//
+	// Constructors/Destructor.
+	//
+	virtual ~CArrayAllocator();
+
+	//
+	// Methods.
+	//
+	void* Allocate(size_t nBytes);
+
+	//! Resize the buffer, which may be NULL, preserving its contents.
+	virtual void* Reallocate(void* pBuffer, size_t nOldBytes, size_t nNewBytes) = 0;
+
+	//! Free a buffer returned by Reallocate().
+	virtual void Free(void* pBuffer, size_t nBytes) = 0;
+
+protected:
+	//
+	// Constructors/Destructor.
+	//
+	CArrayAllocator();
+
+private:
+	// NotCopyable.
+	CArrayAllocator(const CArrayAllocator&);
+	CArrayAllocator& operator=(const CArrayAllocator&);
+};
+
+/******************************************************************************
+**
+** The allocator used for buffers with a specific alignment, e.g. a cache line
+** for SIMD code or to avoid false sharing.
+**
+*******************************************************************************
+*/
+
+class CAlignedAllocator : public CArrayAllocator
+{
+public:
+	// The size of a cache line.
+	enum { CACHE_LINE_SIZE = 64 };
+
+	//
+	// Constructors/Destructor.
+	//
+	explicit CAlignedAllocator(size_t nAlignment = CACHE_LINE_SIZE);
+	virtual ~CAlignedAllocator();
+
+	//
+	// Methods.
+	//
+	virtual void* Reallocate(void* pBuffer, size_t nOldBytes, size_t nNewBytes);
+	virtual void Free(void* pBuffer, size_t nBytes);
+
+private:
+	//
+	// Members.
+	//
+	size_t	m_nAlignment;	//!< The buffer alignment.
+};
+
+/******************************************************************************
+**
+** The allocator used to carve buffers out of large chunks which are all freed
+** together, e.g. for the short-lived arrays of a single request. Only the most
+** recent buffer can be grown in place or reclaimed.
+**
+*******************************************************************************
+*/
+
+class CArenaAllocator : public CArrayAllocator
+{
+public:
+	// The default chunk size.
+	enum { DEF_CHUNK_SIZE = 64 * 1024 };
+
+	//
+	// Constructors/Destructor.
+	//
+	explicit CArenaAllocator(size_t nChunkSize = DEF_CHUNK_SIZE);
+	virtual ~CArenaAllocator();
+
+	//
+	// Methods.
+	//
+	virtual void* Reallocate(void* pBuffer, size_t nOldBytes, size_t nNewBytes);
+	virtual void Free(void* pBuffer, size_t nBytes);
+
+	void Reset();
+
+private:
+	// Template shorthands.
+	typedef std::vector<byte*> Chunks;
+
+	// The alignment of each buffer.
+	enum { ALIGNMENT = 16 };
+
+	//
+	// Members.
+	//
+	size_t	m_nChunkSize;	//!< The default chunk size.
+	Chunks	m_vChunks;		//!< The chunks allocated so far.
+	byte*	m_pNext;		//!< The next free byte in the current chunk.
+	byte*	m_pEnd;			//!< The end of the current chunk.
+	byte*	m_pLast;		//!< The most recent buffer.
+
+	//
+	// Internal methods.
+	//
+	static size_t Align(size_t nBytes);
+};
+
+/******************************************************************************
+**
+** The allocator used to recycle buffers by keeping freed ones in power of two
+** size classes. Buffers larger than the biggest size class use the CRT heap.
+**
+*******************************************************************************
+*/
+
+class CPoolAllocator : public CArrayAllocator
+{
+public:
+	//
+	// Constructors/Destructor.
+	//
+	CPoolAllocator();
+	virtual ~CPoolAllocator();
+
+	//
+	// Methods.
+	//
+	virtual void* Reallocate(void* pBuffer, size_t nOldBytes, size_t nNewBytes);
+	virtual void Free(void* pBuffer, size_t nBytes);
+
+	void Purge();
+
+private:
+	// The size class limits, 16 bytes to 512 KB.
+	enum { MIN_SHIFT = 4, NUM_CLASSES = 16 };
+
+	// A buffer on a free list.
+	struct FreeBlock
+	{
+		FreeBlock*	m_pNext;	//!< The next free buffer.
+	};
+
+	//
+	// Members.
+	//
+	FreeBlock*	m_apFree[NUM_CLASSES];	//!< The free lists.
+
+	//
+	// Internal methods.
+	//
+	static size_t SizeClass(size_t nBytes);
+};
+
+/******************************************************************************
+**
+** The allocator used for very large buffers. Buffers below the threshold use
+** the CRT heap, larger ones reserve address space with VirtualAlloc() and
+** commit pages as they grow so that they can usually be resized in place
+** rather than copied. Large pages can optionally be used if the process holds
+** the privilege, although these must be committed up front.
+** NB: Large buffers are released to the OS as soon as they are freed.
+**
+*******************************************************************************
+*/
+
+class CVirtualAllocator : public CArrayAllocator
+{
+public:
+	// The default buffer size above which virtual memory is used.
+	enum { DEF_THRESHOLD = 1024 * 1024 };
+
+	// The default amount of address space reserved for each buffer.
+	enum { DEF_RESERVE = 256 * 1024 * 1024 };
+
+	//
+	// Constructors/Destructor.
+	//
+	explicit CVirtualAllocator(size_t nThreshold = DEF_THRESHOLD, size_t nReserve = DEF_RESERVE, bool bLargePages = false);
+	virtual ~CVirtualAllocator();
+
+	//
+	// Methods.
+	//
+	virtual void* Reallocate(void* pBuffer, size_t nOldBytes, size_t nNewBytes);
+	virtual void Free(void* pBuffer, size_t nBytes);
+
+private:
+	// The header at the start of each region.
+	struct Region
+	{
+		size_t	m_nReserved;	//!< The address space reserved.
+		size_t	m_nCommitted;	//!< The pages committed, including the header.
+		bool	m_bLargePages;	//!< Committed using large pages?
+	};
+
+	// The size of the header, which keeps the buffer cache line aligned.
+	enum { HEADER_SIZE = 64 };
+
+	//
+	// Members.
+	//
+	size_t	m_nThreshold;		//!< The size above which virtual memory is used.
+	size_t	m_nReserve;			//!< The minimum address space reserved.
+	size_t	m_nPageSize;		//!< The page size.
+	size_t	m_nLargePageSize;	//!< The large page size or 0 if not used.
+
+	//
+	// Internal methods.
+	//
+	bool IsLarge(size_t nBytes) const;
+	void* AllocRegion(size_t nBytes);
+	bool ResizeRegion(void* pBuffer, size_t nBytes);
+
+	static Region* GetRegion(void* pBuffer);
+	static size_t RoundUp(size_t nBytes, size_t nMultiple);
+};
+
+/******************************************************************************
+**
+** Implementation of inline functions.
+**
+*******************************************************************************
+*/
+
+inline void* CArrayAllocator::Allocate(size_t nBytes)
+{
+	return Reallocate(NULL, 0, nBytes);
+}
+
+#endif // ARRAYALLOCATOR_HPP
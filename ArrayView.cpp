@@ -0,0 +1,198 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		ARRAYVIEW.CPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	CArrayView class definition.
+**
+*******************************************************************************
+*/
+
+#include "Common.hpp"
+#include "ArrayView.hpp"
+
+/******************************************************************************
+** Method:		Constructor.
+**
+** Description:	.
+**
+** Parameters:	nItemSize	The size of each item.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CArrayView::CArrayView(size_t nItemSize)
+	: m_nItemSize(nItemSize)
+	, m_hFile(INVALID_HANDLE_VALUE)
+	, m_hMapping(NULL)
+	, m_pView(NULL)
+	, m_pData(NULL)
+	, m_nSize(0)
+{
+	ASSERT(m_nItemSize > 0);
+}
+
+/******************************************************************************
+** Method:		Destructor.
+**
+** Description:	Unmaps the file.
+**
+** Parameters:	None.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CArrayView::~CArrayView()
+{
+	Close();
+}
+
+/******************************************************************************
+** Method:		Open()
+**
+** Description:	Map a file saved by CArray::Save() and validate its header.
+**
+** Parameters:	pszPath		The file path.
+**				nTypeTag	The type tag the file was saved with.
+**				bVerify		Verify the checksum of the items?
+**
+** Returns:		true or false if the file is missing or invalid.
+**
+*******************************************************************************
+*/
+
+bool CArrayView::Open(const tchar* pszPath, uint nTypeTag, bool bVerify)
+{
+	ASSERT(pszPath != NULL);
+
+	Close();
+
+	m_hFile = ::CreateFile(pszPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+	if (m_hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER oFileSize;
+
+	// Too small or too big to map?
+	if ( (!::GetFileSizeEx(m_hFile, &oFileSize)) || (oFileSize.QuadPart < HEADER_SIZE)
+	  || (static_cast<ULONGLONG>(oFileSize.QuadPart) > static_cast<size_t>(-1)) )
+	{
+		Close();
+		return false;
+	}
+
+	m_hMapping = ::CreateFileMapping(m_hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+
+	if (m_hMapping == NULL)
+	{
+		Close();
+		return false;
+	}
+
+	m_pView = static_cast<const byte*>(::MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+
+	if (m_pView == NULL)
+	{
+		Close();
+		return false;
+	}
+
+	const Header* pHeader  = reinterpret_cast<const Header*>(m_pView);
+	size_t        nMaxSize = (static_cast<size_t>(oFileSize.QuadPart) - HEADER_SIZE) / m_nItemSize;
+
+	// Not a file for this type of array?
+	if ( (pHeader->m_dwMagic != FILE_MAGIC) || (pHeader->m_dwVersion != FILE_VERSION)
+	  || (pHeader->m_dwTypeTag != nTypeTag) || (pHeader->m_dwItemSize != m_nItemSize)
+	  || (pHeader->m_nCount > nMaxSize) )
+	{
+		Close();
+		return false;
+	}
+
+	size_t nSize = static_cast<size_t>(pHeader->m_nCount);
+
+	// Corrupt?
+	if ( (bVerify) && (Checksum(m_pView + HEADER_SIZE, nSize * m_nItemSize) != pHeader->m_dwChecksum) )
+	{
+		Close();
+		return false;
+	}
+
+	m_pData = m_pView + HEADER_SIZE;
+	m_nSize = nSize;
+
+	return true;
+}
+
+/******************************************************************************
+** Method:		Close()
+**
+** Description:	Unmap the file, which invalidates any item references.
+**
+** Parameters:	None.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CArrayView::Close()
+{
+	if (m_pView != NULL)
+		::UnmapViewOfFile(m_pView);
+
+	if (m_hMapping != NULL)
+		::CloseHandle(m_hMapping);
+
+	if (m_hFile != INVALID_HANDLE_VALUE)
+		::CloseHandle(m_hFile);
+
+	m_hFile    = INVALID_HANDLE_VALUE;
+	m_hMapping = NULL;
+	m_pView    = NULL;
+	m_pData    = NULL;
+	m_nSize    = 0;
+}
+
+/******************************************************************************
+** Method:		Checksum()
+**
+** Description:	Calculate the checksum of a buffer. This is the FNV-1a hash
+**				applied a word at a time and folded down to 32 bits.
+**
+** Parameters:	pData	The buffer.
+**				nBytes	The buffer size.
+**
+** Returns:		The checksum.
+**
+*******************************************************************************
+*/
+
+DWORD CArrayView::Checksum(const void* pData, size_t nBytes)
+{
+	const ULONGLONG FNV_OFFSET = 14695981039346656037ULL;
+	const ULONGLONG FNV_PRIME  = 1099511628211ULL;
+
+	const byte* pBytes = static_cast<const byte*>(pData);
+	ULONGLONG   nHash  = FNV_OFFSET;
+	size_t      i = 0;
+
+	for (; (i + sizeof(ULONGLONG)) <= nBytes; i += sizeof(ULONGLONG))
+	{
+		ULONGLONG nWord;
+
+		memcpy(&nWord, pBytes + i, sizeof(nWord));
+
+		nHash = (nHash ^ nWord) * FNV_PRIME;
+	}
+
+	for (; i != nBytes; ++i)
+		nHash = (nHash ^ pBytes[i]) * FNV_PRIME;
+
+	return static_cast<DWORD>(nHash ^ (nHash >> 32));
+}
@@ -0,0 +1,118 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		ARRAYVIEW.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The CArrayView class declaration.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef ARRAYVIEW_HPP
+#define ARRAYVIEW_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+/******************************************************************************
+**
+** This is the base class for read-only views of arrays saved to a file with
+** CArray::Save(). The file is memory mapped so that the items are accessed in
+** place without being copied.
+**
+*******************************************************************************
+*/
+
+class CArrayView
+{
+public:
+	// The file format constants.
+	enum
+	{
+		FILE_MAGIC		= 0x5252414C,	// "LARR"
+		FILE_VERSION	= 1,
+		HEADER_SIZE		= 64			// The offset of the items.
+	};
+
+	// The file header.
+	struct Header
+	{
+		DWORD		m_dwMagic;		//!< The file signature.
+		DWORD		m_dwVersion;	//!< The file format version.
+		DWORD		m_dwTypeTag;	//!< The caller defined item type.
+		DWORD		m_dwItemSize;	//!< The size of each item.
+		ULONGLONG	m_nCount;		//!< The number of items.
+		DWORD		m_dwChecksum;	//!< The checksum of the items.
+		DWORD		m_dwReserved;	//!< Unused.
+	};
+
+	//
+	// Attributes.
+	//
+	size_t Size() const;
+	bool IsOpen() const;
+
+	//
+	// Methods.
+	//
+	void Close();
+
+	static DWORD Checksum(const void* pData, size_t nBytes);
+
+protected:
+	//
+	// Constructors/Destructor.
+	//
+	CArrayView(size_t nItemSize);
+	virtual ~CArrayView();
+
+	//
+	// Members.
+	//
+	size_t		m_nItemSize;	//!< The expected item size.
+	HANDLE		m_hFile;		//!< The file handle.
+	HANDLE		m_hMapping;		//!< The file mapping handle.
+	const byte*	m_pView;		//!< The start of the mapped file.
+	const byte*	m_pData;		//!< The first item.
+	size_t		m_nSize;		//!< The number of items.
+
+	//
+	// Internal Methods.
+	//
+	bool Open(const tchar* pszPath, uint nTypeTag, bool bVerify);
+
+	const void* At(size_t nIndex) const;
+
+private:
+	// NotCopyable.
+	CArrayView(const CArrayView&);
+	CArrayView& operator=(const CArrayView&);
+};
+
+/******************************************************************************
+**
+** Implementation of inline functions.
+**
+*******************************************************************************
+*/
+
+inline size_t CArrayView::Size() const
+{
+	return m_nSize;
+}
+
+inline bool CArrayView::IsOpen() const
+{
+	return (m_pView != NULL);
+}
+
+inline const void* CArrayView::At(size_t nIndex) const
+{
+	ASSERT(nIndex < m_nSize);
+
+	return m_pData + (nIndex * m_nItemSize);
+}
+
+#endif // ARRAYVIEW_HPP
@@ -0,0 +1,428 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		BITARRAY.CPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	CBitArray class definition.
+**
+*******************************************************************************
+*/
+
+#include "Common.hpp"
+#include "BitArray.hpp"
+#include "CpuFeatures.hpp"
+
+/******************************************************************************
+** Bit manipulation helpers for the words.
+*/
+
+static inline size_t LowestBit(ULONGLONG nBits)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	unsigned long nBit;
+
+	_BitScanForward64(&nBit, nBits);
+
+	return nBit;
+#elif defined(_MSC_VER)
+	unsigned long nBit;
+
+	if (_BitScanForward(&nBit, static_cast<unsigned long>(nBits)))
+		return nBit;
+
+	_BitScanForward(&nBit, static_cast<unsigned long>(nBits >> 32));
+
+	return nBit + 32;
+#else
+	return __builtin_ctzll(nBits);
+#endif
+}
+
+static inline size_t CountBits(ULONGLONG nBits)
+{
+	nBits = nBits - ((nBits >> 1) & 0x5555555555555555ULL);
+	nBits = (nBits & 0x3333333333333333ULL) + ((nBits >> 2) & 0x3333333333333333ULL);
+	nBits = (nBits + (nBits >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+
+	return static_cast<size_t>((nBits * 0x0101010101010101ULL) >> 56);
+}
+
+/******************************************************************************
+** Count the bits set in the words.
+*/
+
+static size_t ScalarCount(const ULONGLONG* pWords, size_t nCount)
+{
+	size_t nTotal = 0;
+
+	for (size_t i = 0; i != nCount; ++i)
+		nTotal += CountBits(pWords[i]);
+
+	return nTotal;
+}
+
+#ifdef SIMD_POPCNT
+
+static SIMD_TARGET("popcnt") size_t PopCount(const ULONGLONG* pWords, size_t nCount)
+{
+	size_t nTotal = 0;
+
+	for (size_t i = 0; i != nCount; ++i)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		nTotal += static_cast<size_t>(__popcnt64(pWords[i]));
+#elif defined(_MSC_VER)
+		nTotal += __popcnt(static_cast<uint>(pWords[i])) + __popcnt(static_cast<uint>(pWords[i] >> 32));
+#else
+		nTotal += __builtin_popcountll(pWords[i]);
+#endif
+	}
+
+	return nTotal;
+}
+
+#endif
+
+/******************************************************************************
+** Method:		Constructor.
+**
+** Description:	.
+**
+** Parameters:	None.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CBitArray::CBitArray()
+	: m_vWords()
+	, m_nSize(0)
+{
+}
+
+/******************************************************************************
+** Method:		Constructor.
+**
+** Description:	Creates an array with all the bits cleared.
+**
+** Parameters:	nSize	The number of bits.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CBitArray::CBitArray(size_t nSize)
+	: m_vWords()
+	, m_nSize(0)
+{
+	Resize(nSize);
+}
+
+/******************************************************************************
+** Method:		Copy constructor.
+**
+** Description:	The words are shared until either array is modified.
+**
+** Parameters:	oArray	The array to copy.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CBitArray::CBitArray(const CBitArray& oArray)
+	: m_vWords(oArray.m_vWords)
+	, m_nSize(oArray.m_nSize)
+{
+}
+
+/******************************************************************************
+** Method:		Destructor.
+**
+** Description:	.
+**
+** Parameters:	None.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CBitArray::~CBitArray()
+{
+}
+
+/******************************************************************************
+** Method:		Resize()
+**
+** Description:	Changes the number of bits. Any new bits are cleared.
+**
+** Parameters:	nSize	The number of bits.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CBitArray::Resize(size_t nSize)
+{
+	size_t nOldWords = m_vWords.Size();
+	size_t nNewWords = NumWords(nSize);
+
+	if (nNewWords > nOldWords)
+	{
+		m_vWords.Reserve(nNewWords);
+
+		for (size_t i = nOldWords; i != nNewWords; ++i)
+			m_vWords.Add(0);
+	}
+	else if (nNewWords < nOldWords)
+	{
+		m_vWords.RemoveRange(nNewWords, nOldWords - nNewWords);
+	}
+
+	m_nSize = nSize;
+
+	ClearUnusedBits();
+}
+
+/******************************************************************************
+** Method:		SetAll()
+**
+** Description:	Sets or clears all the bits.
+**
+** Parameters:	bValue	The value to set them to.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CBitArray::SetAll(bool bValue)
+{
+	ULONGLONG  nValue = (bValue) ? ~static_cast<ULONGLONG>(0) : 0;
+	ULONGLONG* pWords = m_vWords.begin();
+
+	for (size_t i = 0; i != m_vWords.Size(); ++i)
+		pWords[i] = nValue;
+
+	ClearUnusedBits();
+}
+
+/******************************************************************************
+** Method:		Count()
+**
+** Description:	Counts the bits that are set.
+**
+** Parameters:	None.
+**
+** Returns:		The number of bits set.
+**
+*******************************************************************************
+*/
+
+size_t CBitArray::Count() const
+{
+#ifdef SIMD_POPCNT
+	if (CCpuFeatures::HasPopCount())
+		return PopCount(m_vWords.begin(), m_vWords.Size());
+#endif
+
+	return ScalarCount(m_vWords.begin(), m_vWords.Size());
+}
+
+/******************************************************************************
+** Method:		FindFirstSet()
+**
+** Description:	Finds the first bit that is set.
+**
+** Parameters:	None.
+**
+** Returns:		The index of the bit or Core::npos if none are set.
+**
+*******************************************************************************
+*/
+
+size_t CBitArray::FindFirstSet() const
+{
+	if (m_vWords.Size() == 0)
+		return Core::npos;
+
+	return FindSet(0, m_vWords[0]);
+}
+
+/******************************************************************************
+** Method:		FindNextSet()
+**
+** Description:	Finds the next bit that is set after the one specified.
+**
+** Parameters:	nIndex	The index of the previous bit.
+**
+** Returns:		The index of the bit or Core::npos if no more are set.
+**
+*******************************************************************************
+*/
+
+size_t CBitArray::FindNextSet(size_t nIndex) const
+{
+	ASSERT(nIndex < m_nSize);
+
+	size_t nNext = nIndex + 1;
+
+	if (nNext == m_nSize)
+		return Core::npos;
+
+	size_t    nWord = nNext / WORD_BITS;
+	ULONGLONG nMask = ~static_cast<ULONGLONG>(0) << (nNext % WORD_BITS);
+
+	return FindSet(nWord, m_vWords[nWord] & nMask);
+}
+
+/******************************************************************************
+** Method:		And()
+**
+** Description:	Clears the bits that are not set in another array.
+**
+** Parameters:	oArray	The other array, which must be the same size.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CBitArray::And(const CBitArray& oArray)
+{
+	ASSERT(oArray.m_nSize == m_nSize);
+
+	ULONGLONG*       pWords = m_vWords.begin();
+	const ULONGLONG* pOther = oArray.m_vWords.begin();
+
+	for (size_t i = 0; i != m_vWords.Size(); ++i)
+		pWords[i] &= pOther[i];
+}
+
+/******************************************************************************
+** Method:		Or()
+**
+** Description:	Sets the bits that are set in another array.
+**
+** Parameters:	oArray	The other array, which must be the same size.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CBitArray::Or(const CBitArray& oArray)
+{
+	ASSERT(oArray.m_nSize == m_nSize);
+
+	ULONGLONG*       pWords = m_vWords.begin();
+	const ULONGLONG* pOther = oArray.m_vWords.begin();
+
+	for (size_t i = 0; i != m_vWords.Size(); ++i)
+		pWords[i] |= pOther[i];
+}
+
+/******************************************************************************
+** Method:		Xor()
+**
+** Description:	Flips the bits that are set in another array.
+**
+** Parameters:	oArray	The other array, which must be the same size.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CBitArray::Xor(const CBitArray& oArray)
+{
+	ASSERT(oArray.m_nSize == m_nSize);
+
+	ULONGLONG*       pWords = m_vWords.begin();
+	const ULONGLONG* pOther = oArray.m_vWords.begin();
+
+	for (size_t i = 0; i != m_vWords.Size(); ++i)
+		pWords[i] ^= pOther[i];
+}
+
+/******************************************************************************
+** Method:		AndNot()
+**
+** Description:	Clears the bits that are set in another array.
+**
+** Parameters:	oArray	The other array, which must be the same size.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CBitArray::AndNot(const CBitArray& oArray)
+{
+	ASSERT(oArray.m_nSize == m_nSize);
+
+	ULONGLONG*       pWords = m_vWords.begin();
+	const ULONGLONG* pOther = oArray.m_vWords.begin();
+
+	for (size_t i = 0; i != m_vWords.Size(); ++i)
+		pWords[i] &= ~pOther[i];
+}
+
+/******************************************************************************
+** Method:		ClearUnusedBits()
+**
+** Description:	Clears the bits in the last word that are beyond the end of
+**				the array, so that the words can be counted and scanned whole.
+**
+** Parameters:	None.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CBitArray::ClearUnusedBits()
+{
+	size_t nUsed = m_nSize % WORD_BITS;
+
+	if (nUsed != 0)
+	{
+		ULONGLONG* pLast = m_vWords.end() - 1;
+
+		*pLast &= ~(~static_cast<ULONGLONG>(0) << nUsed);
+	}
+}
+
+/******************************************************************************
+** Method:		FindSet()
+**
+** Description:	Finds the first bit set, starting with the bits of a word and
+**				then scanning the following words.
+**
+** Parameters:	nWord	The index of the first word.
+**				nBits	The bits of the first word to consider.
+**
+** Returns:		The index of the bit or Core::npos if none are set.
+**
+*******************************************************************************
+*/
+
+size_t CBitArray::FindSet(size_t nWord, ULONGLONG nBits) const
+{
+	const ULONGLONG* pWords = m_vWords.begin();
+	size_t           nWords = m_vWords.Size();
+
+	while (nBits == 0)
+	{
+		if (++nWord == nWords)
+			return Core::npos;
+
+		nBits = pWords[nWord];
+	}
+
+	return (nWord * WORD_BITS) + LowestBit(nBits);
+}
@@ -0,0 +1,142 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		BITARRAY.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The CBitArray class declaration.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef BITARRAY_HPP
+#define BITARRAY_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include "TArray.hpp"
+
+/******************************************************************************
+**
+** This is the class used for arrays of flags, which are packed into 64-bit
+** words. The bulk operations work a word at a time and Count() uses the CPU's
+** popcount instruction, if it has one.
+** NB: The unused bits in the last word are always zero.
+**
+*******************************************************************************
+*/
+
+class CBitArray
+{
+public:
+	//
+	// Constructors/Destructor.
+	//
+	CBitArray();
+	explicit CBitArray(size_t nSize);
+	CBitArray(const CBitArray& oArray);
+	~CBitArray();
+
+	//
+	// Methods.
+	//
+	size_t Size() const;
+	void Resize(size_t nSize);
+
+	bool Test(size_t nIndex) const;
+	bool operator[](size_t nIndex) const;
+
+	void Set(size_t nIndex, bool bValue = true);
+	void Clear(size_t nIndex);
+	void SetAll(bool bValue = true);
+	void ClearAll();
+
+	size_t Count() const;
+	size_t FindFirstSet() const;
+	size_t FindNextSet(size_t nIndex) const;
+
+	void And(const CBitArray& oArray);
+	void Or(const CBitArray& oArray);
+	void Xor(const CBitArray& oArray);
+	void AndNot(const CBitArray& oArray);
+
+private:
+	// Template shorthands.
+	typedef TArray<ULONGLONG> CWords;
+
+	// The number of bits in a word.
+	enum { WORD_BITS = 64 };
+
+	//
+	// Members.
+	//
+	CWords	m_vWords;	//!< The bits.
+	size_t	m_nSize;	//!< The number of bits.
+
+	//
+	// Internal methods.
+	//
+	void ClearUnusedBits();
+	size_t FindSet(size_t nWord, ULONGLONG nBits) const;
+
+	static size_t NumWords(size_t nSize);
+
+	// Disallow assignment for now.
+	void operator=(const CBitArray&);
+};
+
+/******************************************************************************
+**
+** Implementation of inline functions.
+**
+*******************************************************************************
+*/
+
+inline size_t CBitArray::Size() const
+{
+	return m_nSize;
+}
+
+inline bool CBitArray::Test(size_t nIndex) const
+{
+	ASSERT(nIndex < m_nSize);
+
+	return ((*(m_vWords.begin() + (nIndex / WORD_BITS)) >> (nIndex % WORD_BITS)) & 1) != 0;
+}
+
+inline bool CBitArray::operator[](size_t nIndex) const
+{
+	return Test(nIndex);
+}
+
+inline void CBitArray::Set(size_t nIndex, bool bValue)
+{
+	ASSERT(nIndex < m_nSize);
+
+	ULONGLONG* pWord = m_vWords.begin() + (nIndex / WORD_BITS);
+	ULONGLONG  nMask = static_cast<ULONGLONG>(1) << (nIndex % WORD_BITS);
+
+	if (bValue)
+		*pWord |= nMask;
+	else
+		*pWord &= ~nMask;
+}
+
+inline void CBitArray::Clear(size_t nIndex)
+{
+	Set(nIndex, false);
+}
+
+inline void CBitArray::ClearAll()
+{
+	SetAll(false);
+}
+
+inline size_t CBitArray::NumWords(size_t nSize)
+{
+	return (nSize + WORD_BITS - 1) / WORD_BITS;
+}
+
+#endif // BITARRAY_HPP
@@ -0,0 +1,158 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		BITPACKING.CPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	CBitPacking class definition.
+**
+*******************************************************************************
+*/
+
+#include "Common.hpp"
+#include "BitPacking.hpp"
+#include "CpuFeatures.hpp"
+#include <string.h>
+
+/******************************************************************************
+** The scalar and SSE2 implementations of Unpack(). The values in a row, i.e.
+** one from each lane, start at the same bit offset and so are consecutive in
+** the output.
+*/
+
+static void ScalarUnpack(const uint* pWords, uint nWidth, uint nMin, uint* pValues)
+{
+	for (size_t i = 0; i != CBitPacking::BLOCK_SIZE; ++i)
+		pValues[i] = nMin + CBitPacking::Extract(pWords, nWidth, i);
+}
+
+#ifdef SIMD_SSE2
+
+static SIMD_TARGET("sse2") void Sse2Unpack(const uint* pWords, uint nWidth, uint nMin, uint* pValues)
+{
+	const size_t nRows = CBitPacking::BLOCK_SIZE / CBitPacking::NUM_LANES;
+
+	__m128i vMask = _mm_set1_epi32((nWidth == 32) ? -1 : static_cast<int>((1u << nWidth) - 1));
+	__m128i vMin  = _mm_set1_epi32(static_cast<int>(nMin));
+
+	for (size_t r = 0; r != nRows; ++r)
+	{
+		size_t nBit   = r * nWidth;
+		size_t nWord  = nBit / 32;
+		uint   nShift = static_cast<uint>(nBit % 32);
+
+		const __m128i* pRow   = reinterpret_cast<const __m128i*>(pWords + (nWord * CBitPacking::NUM_LANES));
+		__m128i        vBits  = _mm_srl_epi32(_mm_loadu_si128(pRow), _mm_cvtsi32_si128(nShift));
+
+		// Spans two words?
+		if ((nShift + nWidth) > 32)
+		{
+			__m128i vNext = _mm_sll_epi32(_mm_loadu_si128(pRow + 1), _mm_cvtsi32_si128(32 - nShift));
+
+			vBits = _mm_or_si128(vBits, vNext);
+		}
+
+		vBits = _mm_add_epi32(_mm_and_si128(vBits, vMask), vMin);
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pValues + (r * CBitPacking::NUM_LANES)), vBits);
+	}
+}
+
+#endif
+
+/******************************************************************************
+** Method:		Width()
+**
+** Description:	Calculates the number of bits required to store a delta.
+**
+** Parameters:	nMaxDelta	The largest delta in the block.
+**
+** Returns:		The number of bits, from 0 to 32.
+**
+*******************************************************************************
+*/
+
+uint CBitPacking::Width(uint nMaxDelta)
+{
+	uint nWidth = 0;
+
+	while ( (nWidth < 32) && ((nMaxDelta >> nWidth) != 0) )
+		++nWidth;
+
+	return nWidth;
+}
+
+/******************************************************************************
+** Method:		Pack()
+**
+** Description:	Packs a block of deltas into the buffer.
+**
+** Parameters:	pDeltas		The BLOCK_SIZE deltas from the block minimum.
+**				nWidth		The number of bits per delta.
+**				pWords		The buffer of NumWords(nWidth) words.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CBitPacking::Pack(const uint* pDeltas, uint nWidth, uint* pWords)
+{
+	if (nWidth == 0)
+		return;
+
+	memset(pWords, 0, NumWords(nWidth) * sizeof(uint));
+
+	for (size_t i = 0; i != BLOCK_SIZE; ++i)
+	{
+		ASSERT((nWidth == 32) || ((pDeltas[i] >> nWidth) == 0));
+
+		size_t nLane  = i % NUM_LANES;
+		size_t nBit   = (i / NUM_LANES) * nWidth;
+		size_t nWord  = nBit / 32;
+		uint   nShift = static_cast<uint>(nBit % 32);
+
+		uint* pLane = pWords + nLane;
+
+		pLane[nWord * NUM_LANES] |= pDeltas[i] << nShift;
+
+		// Spans two words?
+		if ((nShift + nWidth) > 32)
+			pLane[(nWord + 1) * NUM_LANES] |= pDeltas[i] >> (32 - nShift);
+	}
+}
+
+/******************************************************************************
+** Method:		Unpack()
+**
+** Description:	Unpacks a block and adds the block minimum back to the deltas.
+**
+** Parameters:	pWords		The packed block.
+**				nWidth		The number of bits per delta.
+**				nMin		The block minimum.
+**				pValues		The buffer for the BLOCK_SIZE values.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CBitPacking::Unpack(const uint* pWords, uint nWidth, uint nMin, uint* pValues)
+{
+	if (nWidth == 0)
+	{
+		for (size_t i = 0; i != BLOCK_SIZE; ++i)
+			pValues[i] = nMin;
+
+		return;
+	}
+
+#ifdef SIMD_SSE2
+	if (CCpuFeatures::HasSse2())
+	{
+		Sse2Unpack(pWords, nWidth, nMin, pValues);
+		return;
+	}
+#endif
+
+	ScalarUnpack(pWords, nWidth, nMin, pValues);
+}
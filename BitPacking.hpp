@@ -0,0 +1,88 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		BITPACKING.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The CBitPacking class declaration.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef BITPACKING_HPP
+#define BITPACKING_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+/******************************************************************************
+**
+** The class used to pack blocks of 32-bit values into the minimum number of
+** bits. The values are stored relative to the block minimum and interleaved
+** across 4 lanes, i.e. value i is in lane i%4, so that a block can be unpacked
+** 4 values at a time with SSE2, which is selected at runtime.
+**
+** NB: A block of BLOCK_SIZE values packed to N bits occupies 4*N words.
+**
+*******************************************************************************
+*/
+
+class CBitPacking
+{
+public:
+	// The number of values in a block.
+	enum { BLOCK_SIZE = 128 };
+
+	// The number of interleaved lanes.
+	enum { NUM_LANES = 4 };
+
+	//
+	// Methods.
+	//
+	static uint Width(uint nMaxDelta);
+	static size_t NumWords(uint nWidth);
+
+	static void Pack(const uint* pDeltas, uint nWidth, uint* pWords);
+	static void Unpack(const uint* pWords, uint nWidth, uint nMin, uint* pValues);
+	static uint Extract(const uint* pWords, uint nWidth, size_t nIndex);
+};
+
+/******************************************************************************
+**
+** Implementation of inline functions.
+**
+*******************************************************************************
+*/
+
+inline size_t CBitPacking::NumWords(uint nWidth)
+{
+	return NUM_LANES * nWidth;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Extract a single delta from a packed block.
+
+inline uint CBitPacking::Extract(const uint* pWords, uint nWidth, size_t nIndex)
+{
+	ASSERT(nIndex < BLOCK_SIZE);
+
+	if (nWidth == 0)
+		return 0;
+
+	size_t nLane  = nIndex % NUM_LANES;
+	size_t nBit   = (nIndex / NUM_LANES) * nWidth;
+	size_t nWord  = nBit / 32;
+	uint   nShift = static_cast<uint>(nBit % 32);
+
+	const uint* pLane = pWords + nLane;
+	uint        nBits = pLane[nWord * NUM_LANES] >> nShift;
+
+	// Spans two words?
+	if ((nShift + nWidth) > 32)
+		nBits |= pLane[(nWord + 1) * NUM_LANES] << (32 - nShift);
+
+	return (nWidth == 32) ? nBits : (nBits & ((1u << nWidth) - 1));
+}
+
+#endif // BITPACKING_HPP
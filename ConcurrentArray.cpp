@@ -0,0 +1,288 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		CONCURRENTARRAY.CPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	CConcurrentArray class definition.
+**
+*******************************************************************************
+*/
+
+#include "Common.hpp"
+#include "ConcurrentArray.hpp"
+#include <limits.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/******************************************************************************
+** Method:		Constructor.
+**
+** Description:	.
+**
+** Parameters:	nItemSize	The size of each item.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CConcurrentArray::CConcurrentArray(size_t nItemSize)
+	: m_nItemSize(nItemSize)
+	, m_nReserved(0)
+	, m_nCommitted(0)
+{
+	ASSERT(m_nItemSize > 0);
+
+	for (size_t i = 0; i != NUM_SEGMENTS; ++i)
+		m_apSegments[i] = NULL;
+}
+
+/******************************************************************************
+** Method:		Destructor.
+**
+** Description:	Frees the segments.
+**
+** Parameters:	None.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+CConcurrentArray::~CConcurrentArray()
+{
+	RemoveAll();
+}
+
+/******************************************************************************
+** Method:		RemoveAll()
+**
+** Description:	Free all the segments. NB: Not thread safe.
+**
+** Parameters:	None.
+**
+** Returns:		Nothing.
+**
+*******************************************************************************
+*/
+
+void CConcurrentArray::RemoveAll()
+{
+	for (size_t i = 0; i != NUM_SEGMENTS; ++i)
+	{
+		free(m_apSegments[i]);
+
+		m_apSegments[i] = NULL;
+	}
+
+	m_nReserved  = 0;
+	m_nCommitted = 0;
+}
+
+/******************************************************************************
+** Method:		Add()
+**
+** Description:	Add an item to the end of the array.
+**
+** Parameters:	pItem	The item.
+**
+** Returns:		The index of the item.
+**
+*******************************************************************************
+*/
+
+size_t CConcurrentArray::Add(const void* pItem)
+{
+	return AddRange(pItem, 1);
+}
+
+/******************************************************************************
+** Method:		AddRange()
+**
+** Description:	Add a number of items to the end of the array. The slots are
+**				reserved with a single atomic increment so the items are kept
+**				together. Once copied the items are published after those in
+**				the earlier slots, which keeps Size() contiguous.
+**				NB: This blocks until the earlier slots are published.
+**
+** Parameters:	pItems	The items.
+**				nCount	The number of items.
+**
+** Returns:		The index of the first item.
+**
+*******************************************************************************
+*/
+
+size_t CConcurrentArray::AddRange(const void* pItems, size_t nCount)
+{
+	LONGLONG nReserve = static_cast<LONGLONG>(nCount);
+	LONGLONG nFirst   = ::InterlockedExchangeAdd64(&m_nReserved, nReserve);
+
+	// Beyond the last segment?
+	ASSERT(static_cast<ULONGLONG>(nFirst + nReserve) <= MaxSize());
+
+	const byte* pSrc   = static_cast<const byte*>(pItems);
+	size_t      nIndex = static_cast<size_t>(nFirst);
+	size_t      nLeft  = nCount;
+
+	// Copy the items into as many segments as they span.
+	while (nLeft != 0)
+	{
+		size_t nOffset;
+		size_t nSegment = SegmentOf(nIndex, nOffset);
+		size_t nChunk   = SegmentSize(nSegment) - nOffset;
+
+		if (nChunk > nLeft)
+			nChunk = nLeft;
+
+		byte* pSegment = GetSegment(nSegment);
+
+		memcpy(pSegment + (nOffset * m_nItemSize), pSrc, nChunk * m_nItemSize);
+
+		pSrc   += nChunk * m_nItemSize;
+		nIndex += nChunk;
+		nLeft  -= nChunk;
+	}
+
+	// Wait for the threads which reserved the earlier slots to publish theirs.
+	while (::InterlockedCompareExchange64(&m_nCommitted, 0, 0) != nFirst)
+		::SwitchToThread();
+
+	// Publish the items. NB: The interlocked write is a full barrier.
+	::InterlockedExchange64(&m_nCommitted, nFirst + nReserve);
+
+	return static_cast<size_t>(nFirst);
+}
+
+/******************************************************************************
+** Method:		At()
+**
+** Description:	Get an item.
+**
+** Parameters:	nIndex	The index of the item.
+**
+** Returns:		The item.
+**
+*******************************************************************************
+*/
+
+void* CConcurrentArray::At(size_t nIndex) const
+{
+	ASSERT(nIndex < Size());
+
+	size_t nOffset;
+	size_t nSegment = SegmentOf(nIndex, nOffset);
+
+	return m_apSegments[nSegment] + (nOffset * m_nItemSize);
+}
+
+/******************************************************************************
+** Method:		Segment()
+**
+** Description:	Get the items stored in a segment.
+**
+** Parameters:	nSegment	The segment.
+**				nCount		The number of items returned.
+**
+** Returns:		The items or NULL if the segment is beyond the end.
+**
+*******************************************************************************
+*/
+
+const byte* CConcurrentArray::Segment(size_t nSegment, size_t& nCount) const
+{
+	size_t nFirst = SegmentSize(nSegment) - SegmentSize(0);
+
+	nCount = 0;
+
+	if (nFirst >= Size())
+		return NULL;
+
+	nCount = Size() - nFirst;
+
+	if (nCount > SegmentSize(nSegment))
+		nCount = SegmentSize(nSegment);
+
+	return m_apSegments[nSegment];
+}
+
+/******************************************************************************
+** Method:		GetSegment()
+**
+** Description:	Get a segment, allocating it if this is the first thread to
+**				use it. Threads which lose the race to install a segment free
+**				their own and use the winner's.
+**
+** Parameters:	nSegment	The segment.
+**
+** Returns:		The segment.
+**
+*******************************************************************************
+*/
+
+byte* CConcurrentArray::GetSegment(size_t nSegment)
+{
+	ASSERT(nSegment < NUM_SEGMENTS);
+
+	void* volatile* ppSegment = reinterpret_cast<void* volatile*>(&m_apSegments[nSegment]);
+
+	// Read with a barrier so that another thread's segment is seen complete.
+	byte* pSegment = static_cast<byte*>(::InterlockedCompareExchangePointer(ppSegment, NULL, NULL));
+
+	if (pSegment != NULL)
+		return pSegment;
+
+	byte* pNewSegment = static_cast<byte*>(malloc(SegmentSize(nSegment) * m_nItemSize));
+	ASSERT(pNewSegment);
+
+	pSegment = static_cast<byte*>(::InterlockedCompareExchangePointer(ppSegment, pNewSegment, NULL));
+
+	// Lost the race?
+	if (pSegment != NULL)
+	{
+		free(pNewSegment);
+		return pSegment;
+	}
+
+	return pNewSegment;
+}
+
+/******************************************************************************
+** Method:		SegmentOf()
+**
+** Description:	Map an item index onto its segment. Segment n starts at item
+**				(2^n - 1) * 2^FIRST_SHIFT and so the segment is the position of
+**				the highest bit of the biased index.
+**
+** Parameters:	nIndex		The item index.
+**				nOffset		The index of the item within the segment.
+**
+** Returns:		The segment.
+**
+*******************************************************************************
+*/
+
+size_t CConcurrentArray::SegmentOf(size_t nIndex, size_t& nOffset)
+{
+	size_t nBiased = nIndex + SegmentSize(0);
+
+#ifdef _MSC_VER
+	unsigned long nBit;
+
+#ifdef _WIN64
+	_BitScanReverse64(&nBit, nBiased);
+#else
+	_BitScanReverse(&nBit, nBiased);
+#endif
+#else
+	size_t nBit = (sizeof(unsigned long long) * CHAR_BIT) - 1 - __builtin_clzll(nBiased);
+#endif
+
+	size_t nSegment = nBit - FIRST_SHIFT;
+
+	nOffset = nBiased - SegmentSize(nSegment);
+
+	return nSegment;
+}
@@ -0,0 +1,122 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		CONCURRENTARRAY.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The CConcurrentArray class declaration.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef CONCURRENTARRAY_HPP
+#define CONCURRENTARRAY_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+/******************************************************************************
+**
+** This is the base class for arrays which many threads can append to at the
+** same time without a mutex. Each Add() reserves its slots with an atomic
+** increment and the items are stored in segments which double in size and are
+** never moved, so growth doesn't need to stop the other threads.
+**
+** The items are published in the order their slots were reserved, so Size()
+** only counts the items that have been completely written and any index below
+** it can be read by any thread.
+**
+** NB: This is not lock-free. A thread waits for those which reserved earlier
+** slots to publish theirs first, so a thread that is descheduled while copying
+** its items stalls the threads which add after it.
+**
+** NB: Seal() and RemoveAll() are not thread safe.
+**
+*******************************************************************************
+*/
+
+class CConcurrentArray
+{
+public:
+	//
+	// Attributes.
+	//
+	size_t Size() const;
+
+	//
+	// Methods.
+	//
+	void RemoveAll();
+
+protected:
+	// The segment sizes, the first of which holds 1024 items.
+	enum { FIRST_SHIFT = 10, NUM_SEGMENTS = 22 };
+
+	//
+	// Constructors/Destructor.
+	//
+	CConcurrentArray(size_t nItemSize);
+	virtual ~CConcurrentArray();
+
+	//
+	// Members.
+	//
+	size_t				m_nItemSize;					//!< The size of each item.
+	volatile LONGLONG	m_nReserved;					//!< The number of slots reserved.
+	volatile LONGLONG	m_nCommitted;					//!< The number of items written.
+	byte* volatile		m_apSegments[NUM_SEGMENTS];		//!< The segments.
+
+	//
+	// Internal Methods.
+	//
+	size_t Add(const void* pItem);
+	size_t AddRange(const void* pItems, size_t nCount);
+	void* At(size_t nIndex) const;
+
+	const byte* Segment(size_t nSegment, size_t& nCount) const;
+	byte* GetSegment(size_t nSegment);
+
+	static size_t SegmentSize(size_t nSegment);
+	static size_t SegmentOf(size_t nIndex, size_t& nOffset);
+	static ULONGLONG MaxSize();
+
+private:
+	// NotCopyable.
+	CConcurrentArray(const CConcurrentArray&);
+	CConcurrentArray& operator=(const CConcurrentArray&);
+};
+
+/******************************************************************************
+**
+** Implementation of inline functions.
+**
+*******************************************************************************
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+// Get the number of items published. NB: The interlocked read is atomic even
+// on 32-bit Windows.
+
+inline size_t CConcurrentArray::Size() const
+{
+	LONGLONG volatile* pCommitted = const_cast<LONGLONG volatile*>(&m_nCommitted);
+
+	return static_cast<size_t>(::InterlockedCompareExchange64(pCommitted, 0, 0));
+}
+
+inline size_t CConcurrentArray::SegmentSize(size_t nSegment)
+{
+	return static_cast<size_t>(1) << (nSegment + FIRST_SHIFT);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Get the number of items the segments can hold, i.e. (2^NUM_SEGMENTS - 1)
+// * 2^FIRST_SHIFT.
+
+inline ULONGLONG CConcurrentArray::MaxSize()
+{
+	return ((static_cast<ULONGLONG>(1) << NUM_SEGMENTS) - 1) << FIRST_SHIFT;
+}
+
+#endif // CONCURRENTARRAY_HPP
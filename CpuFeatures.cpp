@@ -0,0 +1,96 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		CPUFEATURES.CPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	CCpuFeatures class definition.
+**
+*******************************************************************************
+*/
+
+#include "Common.hpp"
+#include "CpuFeatures.hpp"
+
+/******************************************************************************
+** Method:		Features()
+**
+** Description:	Gets the feature flags, detecting them on the first call.
+**
+** Parameters:	None.
+**
+** Returns:		The feature flags.
+**
+*******************************************************************************
+*/
+
+uint CCpuFeatures::Features()
+{
+	// NB: Racing threads will detect the same flags.
+	static const uint s_nFeatures = Detect();
+
+	return s_nFeatures;
+}
+
+/******************************************************************************
+** Method:		Detect()
+**
+** Description:	Queries the CPU and OS for the supported instruction sets.
+**
+** Parameters:	None.
+**
+** Returns:		The feature flags.
+**
+*******************************************************************************
+*/
+
+uint CCpuFeatures::Detect()
+{
+	uint nFeatures = 0;
+
+#if defined(_MSC_VER) && defined(SIMD_SSE2)
+	int aInfo[4];
+
+	__cpuid(aInfo, 0);
+
+	int nMaxLeaf = aInfo[0];
+
+	__cpuid(aInfo, 1);
+
+	bool bOsXSave = ((aInfo[2] & (1 << 27)) != 0);
+	bool bAvx     = ((aInfo[2] & (1 << 28)) != 0);
+
+	if ((aInfo[3] & (1 << 26)) != 0)
+		nFeatures |= SSE2;
+
+	if ((aInfo[2] & (1 << 23)) != 0)
+		nFeatures |= POPCNT;
+
+#ifdef SIMD_AVX2
+	// AVX2 supported and the OS saves the YMM registers?
+	if ( (nMaxLeaf >= 7) && (bOsXSave) && (bAvx) && ((_xgetbv(0) & 6) == 6) )
+	{
+		__cpuidex(aInfo, 7, 0);
+
+		if ((aInfo[1] & (1 << 5)) != 0)
+			nFeatures |= AVX2;
+	}
+#else
+	(void)nMaxLeaf; (void)bOsXSave; (void)bAvx;
+#endif
+#elif defined(SIMD_SSE2)
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("sse2"))
+		nFeatures |= SSE2;
+
+	if (__builtin_cpu_supports("popcnt"))
+		nFeatures |= POPCNT;
+
+#ifdef SIMD_AVX2
+	if (__builtin_cpu_supports("avx2"))
+		nFeatures |= AVX2;
+#endif
+#endif
+
+	return nFeatures;
+}
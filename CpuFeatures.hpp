@@ -0,0 +1,100 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		CPUFEATURES.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The CCpuFeatures class declaration.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef CPUFEATURES_HPP
+#define CPUFEATURES_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+// The instruction sets that can be compiled for this architecture.
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define SIMD_SSE2
+#define SIMD_POPCNT
+#include <emmintrin.h>
+#if (_MSC_VER >= 1800) || defined(__GNUC__)
+#define SIMD_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+// Compiler specific helpers for the SIMD code.
+#ifdef _MSC_VER
+#include <intrin.h>
+#define SIMD_INLINE				__forceinline
+#define SIMD_TARGET(isa)
+#else
+#define SIMD_INLINE				inline __attribute__((always_inline))
+#define SIMD_TARGET(isa)		__attribute__((target(isa)))
+#endif
+
+/******************************************************************************
+**
+** The class used to query which of the optional instruction sets are
+** supported by the CPU and OS at runtime. The code for an instruction set is
+** compiled when SIMD_<isa> is defined and then selected if HasX() is true.
+**
+** NB: The CPU is queried on first use and so is safe to call during static
+** initialisation.
+**
+*******************************************************************************
+*/
+
+class CCpuFeatures
+{
+public:
+	//
+	// Methods.
+	//
+	static bool HasSse2();
+	static bool HasAvx2();
+	static bool HasPopCount();
+
+private:
+	// The feature flags.
+	enum Feature
+	{
+		SSE2	= 0x0001,
+		AVX2	= 0x0002,
+		POPCNT	= 0x0004
+	};
+
+	//
+	// Internal methods.
+	//
+	static uint Features();
+	static uint Detect();
+};
+
+/******************************************************************************
+**
+** Implementation of inline functions.
+**
+*******************************************************************************
+*/
+
+inline bool CCpuFeatures::HasSse2()
+{
+	return ((Features() & SSE2) != 0);
+}
+
+inline bool CCpuFeatures::HasAvx2()
+{
+	return ((Features() & AVX2) != 0);
+}
+
+inline bool CCpuFeatures::HasPopCount()
+{
+	return ((Features() & POPCNT) != 0);
+}
+
+#endif // CPUFEATURES_HPP
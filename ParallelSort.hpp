@@ -0,0 +1,213 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		PARALLELSORT.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The multi-threaded sort functions.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef PARALLELSORT_HPP
+#define PARALLELSORT_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include <algorithm>
+#include <vector>
+#include <process.h>
+
+/******************************************************************************
+**
+** The class used to sort a buffer in place by sorting partitions of it on a
+** number of worker threads and then merging adjacent partitions pairwise.
+**
+*******************************************************************************
+*/
+
+template<class T, class C> class TParallelSort
+{
+public:
+	// The size below which the serial sort is used.
+	enum { SERIAL_THRESHOLD = 65536 };
+
+	//
+	// Methods.
+	//
+	static void Sort(T* pItems, size_t nCount, C oLess, size_t nThreads);
+
+private:
+	//
+	// The unit of work executed by a worker thread.
+	//
+	struct Task
+	{
+		T*	m_pFirst;		//!< The start of the first partition.
+		T*	m_pMiddle;		//!< The start of the second partition, if merging.
+		T*	m_pLast;		//!< The end of the last partition.
+		C*	m_pLess;		//!< The comparison predicate.
+	};
+
+	//
+	// Internal methods.
+	//
+	static void RunTasks(Task* pTasks, size_t nTasks);
+	static unsigned __stdcall ThreadProc(void* pParam);
+	static void Execute(Task& oTask);
+	static size_t DefaultThreads();
+};
+
+/******************************************************************************
+** Sort the buffer using the given number of threads. A thread count of 0 uses
+** one thread per processor.
+*/
+
+template<class T, class C>
+inline void TParallelSort<T, C>::Sort(T* pItems, size_t nCount, C oLess, size_t nThreads)
+{
+	if (nThreads == 0)
+		nThreads = DefaultThreads();
+
+	// Not worth the overhead of threading?
+	if ( (nCount < SERIAL_THRESHOLD) || (nThreads < 2) )
+	{
+		std::sort(pItems, pItems+nCount, oLess);
+		return;
+	}
+
+	// Don't create partitions smaller than the threshold.
+	nThreads = std::min(nThreads, nCount / (SERIAL_THRESHOLD / 2));
+
+	std::vector<T*>   vBounds(nThreads+1);
+	std::vector<Task> vTasks(nThreads);
+
+	// Split the buffer into equal sized partitions.
+	for (size_t i = 0; i != nThreads; ++i)
+		vBounds[i] = pItems + ((nCount / nThreads) * i);
+
+	vBounds[nThreads] = pItems + nCount;
+
+	// Sort the partitions.
+	for (size_t i = 0; i != nThreads; ++i)
+	{
+		Task oTask = { vBounds[i], NULL, vBounds[i+1], &oLess };
+
+		vTasks[i] = oTask;
+	}
+
+	RunTasks(&vTasks[0], nThreads);
+
+	size_t nPartitions = nThreads;
+
+	// Merge adjacent partitions until only one remains.
+	while (nPartitions > 1)
+	{
+		size_t nMerges = nPartitions / 2;
+
+		for (size_t i = 0; i != nMerges; ++i)
+		{
+			Task oTask = { vBounds[i*2], vBounds[i*2+1], vBounds[i*2+2], &oLess };
+
+			vTasks[i] = oTask;
+		}
+
+		RunTasks(&vTasks[0], nMerges);
+
+		// Remove the bounds between the merged partitions.
+		for (size_t i = 1; i <= nMerges; ++i)
+			vBounds[i] = vBounds[i*2];
+
+		// Carry over any odd partition.
+		if ((nPartitions % 2) != 0)
+			vBounds[nMerges+1] = vBounds[nPartitions];
+
+		nPartitions -= nMerges;
+	}
+}
+
+/******************************************************************************
+** Execute the tasks, one on the calling thread and the rest on worker threads.
+*/
+
+template<class T, class C>
+inline void TParallelSort<T, C>::RunTasks(Task* pTasks, size_t nTasks)
+{
+	std::vector<HANDLE> vThreads(nTasks);
+
+	// Start the worker threads.
+	for (size_t i = 1; i != nTasks; ++i)
+	{
+		vThreads[i] = reinterpret_cast<HANDLE>(_beginthreadex(NULL, 0, ThreadProc, &pTasks[i], 0, NULL));
+
+		// Failed to start thread?
+		if (vThreads[i] == NULL)
+			Execute(pTasks[i]);
+	}
+
+	Execute(pTasks[0]);
+
+	// Wait for the workers to finish.
+	for (size_t i = 1; i != nTasks; ++i)
+	{
+		if (vThreads[i] != NULL)
+		{
+			::WaitForSingleObject(vThreads[i], INFINITE);
+			::CloseHandle(vThreads[i]);
+		}
+	}
+}
+
+/******************************************************************************
+** The worker thread entry point.
+*/
+
+template<class T, class C>
+inline unsigned __stdcall TParallelSort<T, C>::ThreadProc(void* pParam)
+{
+	Execute(*static_cast<Task*>(pParam));
+
+	return 0;
+}
+
+/******************************************************************************
+** Execute a single sort or merge task.
+*/
+
+template<class T, class C>
+inline void TParallelSort<T, C>::Execute(Task& oTask)
+{
+	if (oTask.m_pMiddle == NULL)
+		std::sort(oTask.m_pFirst, oTask.m_pLast, *oTask.m_pLess);
+	else
+		std::inplace_merge(oTask.m_pFirst, oTask.m_pMiddle, oTask.m_pLast, *oTask.m_pLess);
+}
+
+/******************************************************************************
+** Get the default number of threads, which is one per processor.
+*/
+
+template<class T, class C>
+inline size_t TParallelSort<T, C>::DefaultThreads()
+{
+	SYSTEM_INFO oInfo;
+
+	::GetSystemInfo(&oInfo);
+
+	return oInfo.dwNumberOfProcessors;
+}
+
+/******************************************************************************
+** Sort the items in place using multiple threads. A thread count of 0 uses one
+** thread per processor.
+*/
+
+template<class T, class C>
+inline void ParallelSort(T* pItems, size_t nCount, C oLess, size_t nThreads = 0)
+{
+	TParallelSort<T, C>::Sort(pItems, nCount, oLess, nThreads);
+}
+
+#endif // PARALLELSORT_HPP
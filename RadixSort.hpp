@@ -0,0 +1,371 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		RADIXSORT.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The LSD radix sort functions and key traits.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef RADIXSORT_HPP
+#define RADIXSORT_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include "TypeTraits.hpp"
+#include <algorithm>
+#include <climits>
+
+/******************************************************************************
+**
+** The traits class used to map a type onto an unsigned key which has the same
+** ordering. Only arithmetic and pointer types can be radix sorted.
+**
+*******************************************************************************
+*/
+
+template<class T> struct TRadixKey
+{
+	enum { IS_SORTABLE = false };
+};
+
+/******************************************************************************
+**
+** The key traits for unsigned types, which are their own key.
+**
+*******************************************************************************
+*/
+
+template<class T> struct TUnsignedRadixKey
+{
+	enum { IS_SORTABLE = true };
+
+	typedef T KeyType;
+
+	static KeyType Key(T Item)
+	{
+		return Item;
+	}
+
+	KeyType operator()(T Item) const
+	{
+		return Key(Item);
+	}
+};
+
+/******************************************************************************
+**
+** The key traits for signed types, which flip the sign bit so that negative
+** values sort before positive ones.
+**
+*******************************************************************************
+*/
+
+template<class T, class U> struct TSignedRadixKey
+{
+	enum { IS_SORTABLE = true };
+
+	typedef U KeyType;
+
+	static KeyType Key(T Item)
+	{
+		return static_cast<U>(Item) ^ (static_cast<U>(1) << ((sizeof(U) * CHAR_BIT) - 1));
+	}
+
+	KeyType operator()(T Item) const
+	{
+		return Key(Item);
+	}
+};
+
+/******************************************************************************
+**
+** The key traits for IEEE floating point types. Negative values have all their
+** bits flipped so that they sort in reverse, positive values have the sign bit
+** flipped so that they sort after the negative ones.
+**
+*******************************************************************************
+*/
+
+template<class T, class U> struct TFloatRadixKey
+{
+	enum { IS_SORTABLE = true };
+
+	typedef U KeyType;
+
+	static KeyType Key(T Item)
+	{
+		const U nSignBit = static_cast<U>(1) << ((sizeof(U) * CHAR_BIT) - 1);
+
+		U nBits;
+
+		memcpy(&nBits, &Item, sizeof(nBits));
+
+		return (nBits & nSignBit) ? ~nBits : (nBits | nSignBit);
+	}
+
+	KeyType operator()(T Item) const
+	{
+		return Key(Item);
+	}
+};
+
+/******************************************************************************
+**
+** The key traits specialisations for the built-in types.
+**
+*******************************************************************************
+*/
+
+template<> struct TRadixKey<unsigned char>  : public TUnsignedRadixKey<unsigned char>  { };
+template<> struct TRadixKey<unsigned short> : public TUnsignedRadixKey<unsigned short> { };
+template<> struct TRadixKey<unsigned int>   : public TUnsignedRadixKey<unsigned int>   { };
+template<> struct TRadixKey<unsigned long>  : public TUnsignedRadixKey<unsigned long>  { };
+template<> struct TRadixKey<ULONGLONG>      : public TUnsignedRadixKey<ULONGLONG>      { };
+
+template<> struct TRadixKey<signed char>    : public TSignedRadixKey<signed char, unsigned char>  { };
+template<> struct TRadixKey<short>          : public TSignedRadixKey<short, unsigned short>       { };
+template<> struct TRadixKey<int>            : public TSignedRadixKey<int, unsigned int>           { };
+template<> struct TRadixKey<long>           : public TSignedRadixKey<long, unsigned long>         { };
+template<> struct TRadixKey<LONGLONG>       : public TSignedRadixKey<LONGLONG, ULONGLONG>         { };
+
+template<> struct TRadixKey<float>          : public TFloatRadixKey<float, unsigned int>          { };
+template<> struct TRadixKey<double>         : public TFloatRadixKey<double, ULONGLONG>            { };
+
+template<> struct TRadixKey<char>
+{
+	enum { IS_SORTABLE = true };
+
+	typedef unsigned char KeyType;
+
+	static KeyType Key(char Item)
+	{
+		return static_cast<KeyType>(static_cast<int>(Item) - CHAR_MIN);
+	}
+
+	KeyType operator()(char Item) const
+	{
+		return Key(Item);
+	}
+};
+
+template<class T> struct TRadixKey<T*>
+{
+	enum { IS_SORTABLE = true };
+
+	typedef UINT_PTR KeyType;
+
+	static KeyType Key(T* Item)
+	{
+		return reinterpret_cast<KeyType>(Item);
+	}
+
+	KeyType operator()(T* Item) const
+	{
+		return Key(Item);
+	}
+};
+
+/******************************************************************************
+**
+** The traits class used to determine the type returned by a key extractor
+** for an item. With C++11 this is deduced from the call, which also supports
+** lambdas, otherwise functors must provide a result_type typedef, e.g. via
+** std::unary_function.
+**
+*******************************************************************************
+*/
+
+#ifdef LEGACY_HAS_CXX11
+
+template<class F, class T> struct TKeyResult
+{
+	typedef typename std::decay<decltype(std::declval<F&>()(std::declval<const T&>()))>::type Type;
+};
+
+#else
+
+template<class F, class T> struct TKeyResult
+{
+	typedef typename F::result_type Type;
+};
+
+template<class R, class A, class T> struct TKeyResult<R (*)(A), T>
+{
+	typedef R Type;
+};
+
+#endif
+
+/******************************************************************************
+**
+** The adapter used to map the value returned by a key extractor onto a key.
+**
+*******************************************************************************
+*/
+
+template<class F, class T> class TRadixKeyAdapter
+{
+public:
+	// Template shorthands.
+	typedef typename TKeyResult<F, T>::Type	ResultType;
+	typedef TRadixKey<ResultType>			KeyTraits;
+	typedef typename KeyTraits::KeyType		KeyType;
+
+	TRadixKeyAdapter(F oKey)
+		: m_oKey(oKey)
+	{
+	}
+
+	KeyType operator()(const T& Item) const
+	{
+		return KeyTraits::Key(m_oKey(Item));
+	}
+
+private:
+	//
+	// Members.
+	//
+	F	m_oKey;		//!< The key extractor.
+};
+
+/******************************************************************************
+** Sort the items using an LSD radix sort on the keys returned by the key
+** functor. The keys are extracted once and then sorted a byte at a time, with
+** any byte that is the same for every item skipped. The items must be
+** trivially copyable.
+*/
+
+template<class T, class K>
+inline void RadixSort(T* pItems, size_t nCount, K oKey)
+{
+	typedef typename K::KeyType KeyType;
+
+	const size_t NUM_PASSES  = sizeof(KeyType);
+	const size_t NUM_BUCKETS = 256;
+
+	if (nCount < 2)
+		return;
+
+	// Allocate the scratch buffers.
+	KeyType* pKeys  = static_cast<KeyType*>(malloc(2 * nCount * sizeof(KeyType)));
+	T*       pTemp  = static_cast<T*>(malloc(nCount * sizeof(T)));
+
+	ASSERT((pKeys != NULL) && (pTemp != NULL));
+
+	KeyType* pSrcKeys  = pKeys;
+	KeyType* pDstKeys  = pKeys + nCount;
+	T*       pSrcItems = pItems;
+	T*       pDstItems = pTemp;
+
+	size_t aCounts[NUM_PASSES][NUM_BUCKETS] = { { 0 } };
+
+	// Extract the keys and build all the histograms in one pass.
+	for (size_t i = 0; i != nCount; ++i)
+	{
+		KeyType nKey = oKey(pItems[i]);
+
+		pSrcKeys[i] = nKey;
+
+		for (size_t p = 0; p != NUM_PASSES; ++p)
+			++aCounts[p][(nKey >> (p * CHAR_BIT)) & 0xFF];
+	}
+
+	for (size_t p = 0; p != NUM_PASSES; ++p)
+	{
+		size_t* pCounts = aCounts[p];
+		size_t  nShift  = p * CHAR_BIT;
+
+		// Every key has the same digit?
+		if (pCounts[(pSrcKeys[0] >> nShift) & 0xFF] == nCount)
+			continue;
+
+		size_t aOffsets[NUM_BUCKETS];
+		size_t nOffset = 0;
+
+		// Convert the counts into bucket offsets.
+		for (size_t b = 0; b != NUM_BUCKETS; ++b)
+		{
+			aOffsets[b] = nOffset;
+			nOffset    += pCounts[b];
+		}
+
+		// Scatter the keys and items into their buckets.
+		for (size_t i = 0; i != nCount; ++i)
+		{
+			KeyType nKey = pSrcKeys[i];
+			size_t  nPos = aOffsets[(nKey >> nShift) & 0xFF]++;
+
+			pDstKeys[nPos]  = nKey;
+			pDstItems[nPos] = pSrcItems[i];
+		}
+
+		std::swap(pSrcKeys,  pDstKeys);
+		std::swap(pSrcItems, pDstItems);
+	}
+
+	// Sorted items ended up in the scratch buffer?
+	if (pSrcItems != pItems)
+		memcpy(pItems, pSrcItems, nCount * sizeof(T));
+
+	free(pTemp);
+	free(pKeys);
+}
+
+/******************************************************************************
+** Sort the arithmetic or pointer items using an LSD radix sort.
+*/
+
+template<class T>
+inline void RadixSort(T* pItems, size_t nCount)
+{
+	RadixSort(pItems, nCount, TRadixKey<T>());
+}
+
+/******************************************************************************
+**
+** The helper used to choose the sorting algorithm at compile time, based on
+** whether the item type can be radix sorted.
+**
+*******************************************************************************
+*/
+
+template<bool IS_SORTABLE> struct TDefaultSort
+{
+	template<class T>
+	static void Sort(T* pItems, size_t nCount)
+	{
+		std::sort(pItems, pItems+nCount);
+	}
+};
+
+template<> struct TDefaultSort<true>
+{
+	// The size below which a comparison sort is faster.
+	enum { RADIX_THRESHOLD = 256 };
+
+	template<class T>
+	static void Sort(T* pItems, size_t nCount)
+	{
+		if (nCount < RADIX_THRESHOLD)
+			std::sort(pItems, pItems+nCount);
+		else
+			RadixSort(pItems, nCount);
+	}
+};
+
+/******************************************************************************
+** Sort the items into ascending order using the fastest available algorithm.
+*/
+
+template<class T>
+inline void DefaultSort(T* pItems, size_t nCount)
+{
+	TDefaultSort<TRadixKey<T>::IS_SORTABLE>::Sort(pItems, nCount);
+}
+
+#endif // RADIXSORT_HPP
@@ -0,0 +1,463 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		SIMDSEARCH.CPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	CSimdSearch class definition.
+**
+*******************************************************************************
+*/
+
+#include "Common.hpp"
+#include "SimdSearch.hpp"
+#include "CpuFeatures.hpp"
+
+/******************************************************************************
+** Bit manipulation helpers for the comparison masks.
+*/
+
+static SIMD_INLINE uint LowestBit(uint nMask)
+{
+#ifdef _MSC_VER
+	unsigned long nBit;
+
+	_BitScanForward(&nBit, nMask);
+
+	return nBit;
+#else
+	return __builtin_ctz(nMask);
+#endif
+}
+
+static SIMD_INLINE uint HighestBit(uint nMask)
+{
+#ifdef _MSC_VER
+	unsigned long nBit;
+
+	_BitScanReverse(&nBit, nMask);
+
+	return nBit;
+#else
+	return 31 - __builtin_clz(nMask);
+#endif
+}
+
+static SIMD_INLINE uint CountBits(uint nMask)
+{
+	nMask = nMask - ((nMask >> 1) & 0x55555555);
+	nMask = (nMask & 0x33333333) + ((nMask >> 2) & 0x33333333);
+
+	return (((nMask + (nMask >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+}
+
+/******************************************************************************
+** The scalar implementations, which are also used for the remaining items that
+** don't fill a vector.
+*/
+
+template<class U>
+static size_t ScalarFind(const U* pItems, size_t nFirst, size_t nLast, U nValue)
+{
+	for (size_t i = nFirst; i != nLast; ++i)
+	{
+		if (pItems[i] == nValue)
+			return i;
+	}
+
+	return Core::npos;
+}
+
+template<class U>
+static size_t ScalarFindLast(const U* pItems, size_t nFirst, size_t nLast, U nValue)
+{
+	for (size_t i = nLast; i != nFirst; --i)
+	{
+		if (pItems[i-1] == nValue)
+			return i-1;
+	}
+
+	return Core::npos;
+}
+
+template<class U>
+static size_t ScalarCount(const U* pItems, size_t nFirst, size_t nLast, U nValue)
+{
+	size_t nCount = 0;
+
+	for (size_t i = nFirst; i != nLast; ++i)
+	{
+		if (pItems[i] == nValue)
+			++nCount;
+	}
+
+	return nCount;
+}
+
+#ifdef SIMD_SSE2
+
+/******************************************************************************
+** The SSE2 implementations. Each comparison yields a mask with one bit per
+** byte and so sizeof(U) bits per item.
+*/
+
+static SIMD_INLINE SIMD_TARGET("sse2") __m128i Sse2Splat(unsigned char nValue)
+{
+	return _mm_set1_epi8(static_cast<char>(nValue));
+}
+
+static SIMD_INLINE SIMD_TARGET("sse2") __m128i Sse2Splat(unsigned short nValue)
+{
+	return _mm_set1_epi16(static_cast<short>(nValue));
+}
+
+static SIMD_INLINE SIMD_TARGET("sse2") __m128i Sse2Splat(unsigned int nValue)
+{
+	return _mm_set1_epi32(static_cast<int>(nValue));
+}
+
+static SIMD_INLINE SIMD_TARGET("sse2") __m128i Sse2Splat(ULONGLONG nValue)
+{
+	__m128i vValue = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&nValue));
+
+	return _mm_unpacklo_epi64(vValue, vValue);
+}
+
+static SIMD_INLINE SIMD_TARGET("sse2") __m128i Sse2CmpEq(__m128i vLhs, __m128i vRhs, unsigned char)
+{
+	return _mm_cmpeq_epi8(vLhs, vRhs);
+}
+
+static SIMD_INLINE SIMD_TARGET("sse2") __m128i Sse2CmpEq(__m128i vLhs, __m128i vRhs, unsigned short)
+{
+	return _mm_cmpeq_epi16(vLhs, vRhs);
+}
+
+static SIMD_INLINE SIMD_TARGET("sse2") __m128i Sse2CmpEq(__m128i vLhs, __m128i vRhs, unsigned int)
+{
+	return _mm_cmpeq_epi32(vLhs, vRhs);
+}
+
+static SIMD_INLINE SIMD_TARGET("sse2") __m128i Sse2CmpEq(__m128i vLhs, __m128i vRhs, ULONGLONG)
+{
+	// No 64-bit compare so both 32-bit halves must match.
+	__m128i vEqual = _mm_cmpeq_epi32(vLhs, vRhs);
+
+	return _mm_and_si128(vEqual, _mm_shuffle_epi32(vEqual, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+template<class U>
+static SIMD_INLINE SIMD_TARGET("sse2") uint Sse2Match(const U* pItems, __m128i vValue)
+{
+	__m128i vItems = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pItems));
+
+	return _mm_movemask_epi8(Sse2CmpEq(vItems, vValue, U()));
+}
+
+template<class U>
+static SIMD_TARGET("sse2") size_t Sse2Find(const U* pItems, size_t nCount, U nValue)
+{
+	const size_t nLanes = sizeof(__m128i) / sizeof(U);
+
+	__m128i vValue = Sse2Splat(nValue);
+	size_t  i = 0;
+
+	for (; (i + nLanes) <= nCount; i += nLanes)
+	{
+		uint nMask = Sse2Match(pItems + i, vValue);
+
+		if (nMask != 0)
+			return i + (LowestBit(nMask) / sizeof(U));
+	}
+
+	return ScalarFind(pItems, i, nCount, nValue);
+}
+
+template<class U>
+static SIMD_TARGET("sse2") size_t Sse2FindLast(const U* pItems, size_t nCount, U nValue)
+{
+	const size_t nLanes = sizeof(__m128i) / sizeof(U);
+
+	__m128i vValue = Sse2Splat(nValue);
+	size_t  i = nCount;
+
+	for (; i >= nLanes; i -= nLanes)
+	{
+		uint nMask = Sse2Match(pItems + i - nLanes, vValue);
+
+		if (nMask != 0)
+			return i - nLanes + (HighestBit(nMask) / sizeof(U));
+	}
+
+	return ScalarFindLast(pItems, 0, i, nValue);
+}
+
+template<class U>
+static SIMD_TARGET("sse2") size_t Sse2Count(const U* pItems, size_t nCount, U nValue)
+{
+	const size_t nLanes = sizeof(__m128i) / sizeof(U);
+
+	__m128i vValue = Sse2Splat(nValue);
+	size_t  nBits  = 0;
+	size_t  i = 0;
+
+	for (; (i + nLanes) <= nCount; i += nLanes)
+		nBits += CountBits(Sse2Match(pItems + i, vValue));
+
+	return (nBits / sizeof(U)) + ScalarCount(pItems, i, nCount, nValue);
+}
+
+#endif // SIMD_SSE2
+
+#ifdef SIMD_AVX2
+
+/******************************************************************************
+** The AVX2 implementations, which are the SSE2 ones using 256-bit vectors.
+*/
+
+static SIMD_INLINE SIMD_TARGET("avx2") __m256i Avx2Splat(unsigned char nValue)
+{
+	return _mm256_set1_epi8(static_cast<char>(nValue));
+}
+
+static SIMD_INLINE SIMD_TARGET("avx2") __m256i Avx2Splat(unsigned short nValue)
+{
+	return _mm256_set1_epi16(static_cast<short>(nValue));
+}
+
+static SIMD_INLINE SIMD_TARGET("avx2") __m256i Avx2Splat(unsigned int nValue)
+{
+	return _mm256_set1_epi32(static_cast<int>(nValue));
+}
+
+static SIMD_INLINE SIMD_TARGET("avx2") __m256i Avx2Splat(ULONGLONG nValue)
+{
+	return _mm256_broadcastq_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&nValue)));
+}
+
+static SIMD_INLINE SIMD_TARGET("avx2") __m256i Avx2CmpEq(__m256i vLhs, __m256i vRhs, unsigned char)
+{
+	return _mm256_cmpeq_epi8(vLhs, vRhs);
+}
+
+static SIMD_INLINE SIMD_TARGET("avx2") __m256i Avx2CmpEq(__m256i vLhs, __m256i vRhs, unsigned short)
+{
+	return _mm256_cmpeq_epi16(vLhs, vRhs);
+}
+
+static SIMD_INLINE SIMD_TARGET("avx2") __m256i Avx2CmpEq(__m256i vLhs, __m256i vRhs, unsigned int)
+{
+	return _mm256_cmpeq_epi32(vLhs, vRhs);
+}
+
+static SIMD_INLINE SIMD_TARGET("avx2") __m256i Avx2CmpEq(__m256i vLhs, __m256i vRhs, ULONGLONG)
+{
+	return _mm256_cmpeq_epi64(vLhs, vRhs);
+}
+
+template<class U>
+static SIMD_INLINE SIMD_TARGET("avx2") uint Avx2Match(const U* pItems, __m256i vValue)
+{
+	__m256i vItems = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pItems));
+
+	return static_cast<uint>(_mm256_movemask_epi8(Avx2CmpEq(vItems, vValue, U())));
+}
+
+template<class U>
+static SIMD_TARGET("avx2") size_t Avx2Find(const U* pItems, size_t nCount, U nValue)
+{
+	const size_t nLanes = sizeof(__m256i) / sizeof(U);
+
+	__m256i vValue = Avx2Splat(nValue);
+	size_t  i = 0;
+
+	for (; (i + nLanes) <= nCount; i += nLanes)
+	{
+		uint nMask = Avx2Match(pItems + i, vValue);
+
+		if (nMask != 0)
+			return i + (LowestBit(nMask) / sizeof(U));
+	}
+
+	return ScalarFind(pItems, i, nCount, nValue);
+}
+
+template<class U>
+static SIMD_TARGET("avx2") size_t Avx2FindLast(const U* pItems, size_t nCount, U nValue)
+{
+	const size_t nLanes = sizeof(__m256i) / sizeof(U);
+
+	__m256i vValue = Avx2Splat(nValue);
+	size_t  i = nCount;
+
+	for (; i >= nLanes; i -= nLanes)
+	{
+		uint nMask = Avx2Match(pItems + i - nLanes, vValue);
+
+		if (nMask != 0)
+			return i - nLanes + (HighestBit(nMask) / sizeof(U));
+	}
+
+	return ScalarFindLast(pItems, 0, i, nValue);
+}
+
+template<class U>
+static SIMD_TARGET("avx2") size_t Avx2Count(const U* pItems, size_t nCount, U nValue)
+{
+	const size_t nLanes = sizeof(__m256i) / sizeof(U);
+
+	__m256i vValue = Avx2Splat(nValue);
+	size_t  nBits  = 0;
+	size_t  i = 0;
+
+	for (; (i + nLanes) <= nCount; i += nLanes)
+		nBits += CountBits(Avx2Match(pItems + i, vValue));
+
+	return (nBits / sizeof(U)) + ScalarCount(pItems, i, nCount, nValue);
+}
+
+#endif // SIMD_AVX2
+
+/******************************************************************************
+** Select the implementation for the instruction set.
+*/
+
+template<class U>
+static size_t FindItems(const void* pItems, size_t nCount, ULONGLONG nValue)
+{
+	const U* pBuffer = static_cast<const U*>(pItems);
+	U        nItem   = static_cast<U>(nValue);
+
+#ifdef SIMD_AVX2
+	if (CCpuFeatures::HasAvx2())
+		return Avx2Find(pBuffer, nCount, nItem);
+#endif
+#ifdef SIMD_SSE2
+	if (CCpuFeatures::HasSse2())
+		return Sse2Find(pBuffer, nCount, nItem);
+#endif
+
+	return ScalarFind(pBuffer, 0, nCount, nItem);
+}
+
+template<class U>
+static size_t FindLastItem(const void* pItems, size_t nCount, ULONGLONG nValue)
+{
+	const U* pBuffer = static_cast<const U*>(pItems);
+	U        nItem   = static_cast<U>(nValue);
+
+#ifdef SIMD_AVX2
+	if (CCpuFeatures::HasAvx2())
+		return Avx2FindLast(pBuffer, nCount, nItem);
+#endif
+#ifdef SIMD_SSE2
+	if (CCpuFeatures::HasSse2())
+		return Sse2FindLast(pBuffer, nCount, nItem);
+#endif
+
+	return ScalarFindLast(pBuffer, 0, nCount, nItem);
+}
+
+template<class U>
+static size_t CountItems(const void* pItems, size_t nCount, ULONGLONG nValue)
+{
+	const U* pBuffer = static_cast<const U*>(pItems);
+	U        nItem   = static_cast<U>(nValue);
+
+#ifdef SIMD_AVX2
+	if (CCpuFeatures::HasAvx2())
+		return Avx2Count(pBuffer, nCount, nItem);
+#endif
+#ifdef SIMD_SSE2
+	if (CCpuFeatures::HasSse2())
+		return Sse2Count(pBuffer, nCount, nItem);
+#endif
+
+	return ScalarCount(pBuffer, 0, nCount, nItem);
+}
+
+/******************************************************************************
+** Method:		Find()
+**
+** Description:	Find the first item with the given value.
+**
+** Parameters:	pItems		The buffer.
+**				nCount		The number of items.
+**				nItemSize	The item size, which must be 1, 2, 4 or 8 bytes.
+**				nValue		The bit pattern of the value.
+**
+** Returns:		The index of the item or Core::npos if not found.
+**
+*******************************************************************************
+*/
+
+size_t CSimdSearch::Find(const void* pItems, size_t nCount, size_t nItemSize, ULONGLONG nValue)
+{
+	switch (nItemSize)
+	{
+		case 1:	return FindItems<unsigned char>(pItems, nCount, nValue);
+		case 2:	return FindItems<unsigned short>(pItems, nCount, nValue);
+		case 4:	return FindItems<unsigned int>(pItems, nCount, nValue);
+		case 8:	return FindItems<ULONGLONG>(pItems, nCount, nValue);
+		default:	ASSERT_FALSE();	break;
+	}
+
+	return Core::npos;
+}
+
+/******************************************************************************
+** Method:		FindLast()
+**
+** Description:	Find the last item with the given value.
+**
+** Parameters:	pItems		The buffer.
+**				nCount		The number of items.
+**				nItemSize	The item size, which must be 1, 2, 4 or 8 bytes.
+**				nValue		The bit pattern of the value.
+**
+** Returns:		The index of the item or Core::npos if not found.
+**
+*******************************************************************************
+*/
+
+size_t CSimdSearch::FindLast(const void* pItems, size_t nCount, size_t nItemSize, ULONGLONG nValue)
+{
+	switch (nItemSize)
+	{
+		case 1:	return FindLastItem<unsigned char>(pItems, nCount, nValue);
+		case 2:	return FindLastItem<unsigned short>(pItems, nCount, nValue);
+		case 4:	return FindLastItem<unsigned int>(pItems, nCount, nValue);
+		case 8:	return FindLastItem<ULONGLONG>(pItems, nCount, nValue);
+		default:	ASSERT_FALSE();	break;
+	}
+
+	return Core::npos;
+}
+
+/******************************************************************************
+** Method:		Count()
+**
+** Description:	Count the items with the given value.
+**
+** Parameters:	pItems		The buffer.
+**				nCount		The number of items.
+**				nItemSize	The item size, which must be 1, 2, 4 or 8 bytes.
+**				nValue		The bit pattern of the value.
+**
+** Returns:		The number of matching items.
+**
+*******************************************************************************
+*/
+
+size_t CSimdSearch::Count(const void* pItems, size_t nCount, size_t nItemSize, ULONGLONG nValue)
+{
+	switch (nItemSize)
+	{
+		case 1:	return CountItems<unsigned char>(pItems, nCount, nValue);
+		case 2:	return CountItems<unsigned short>(pItems, nCount, nValue);
+		case 4:	return CountItems<unsigned int>(pItems, nCount, nValue);
+		case 8:	return CountItems<ULONGLONG>(pItems, nCount, nValue);
+		default:	ASSERT_FALSE();	break;
+	}
+
+	return 0;
+}
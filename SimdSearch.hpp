@@ -0,0 +1,103 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		SIMDSEARCH.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The CSimdSearch class declaration.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef SIMDSEARCH_HPP
+#define SIMDSEARCH_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+/******************************************************************************
+**
+** The traits class used to map a type onto the bit pattern compared by the
+** SIMD search functions. Only integral and pointer types can be searched as
+** their equality is the same as bitwise equality.
+**
+*******************************************************************************
+*/
+
+template<class T> struct TSimdSearchKey
+{
+	enum { IS_SEARCHABLE = false };
+};
+
+/******************************************************************************
+**
+** The key traits for integral types.
+**
+*******************************************************************************
+*/
+
+template<class T> struct TIntegralSearchKey
+{
+	enum { IS_SEARCHABLE = true };
+
+	static ULONGLONG Bits(T Item)
+	{
+		return static_cast<ULONGLONG>(Item);
+	}
+};
+
+/******************************************************************************
+**
+** The key traits specialisations for the built-in types.
+**
+*******************************************************************************
+*/
+
+template<> struct TSimdSearchKey<char>           : public TIntegralSearchKey<char>           { };
+template<> struct TSimdSearchKey<signed char>    : public TIntegralSearchKey<signed char>    { };
+template<> struct TSimdSearchKey<unsigned char>  : public TIntegralSearchKey<unsigned char>  { };
+template<> struct TSimdSearchKey<short>          : public TIntegralSearchKey<short>          { };
+template<> struct TSimdSearchKey<unsigned short> : public TIntegralSearchKey<unsigned short> { };
+template<> struct TSimdSearchKey<int>            : public TIntegralSearchKey<int>            { };
+template<> struct TSimdSearchKey<unsigned int>   : public TIntegralSearchKey<unsigned int>   { };
+template<> struct TSimdSearchKey<long>           : public TIntegralSearchKey<long>           { };
+template<> struct TSimdSearchKey<unsigned long>  : public TIntegralSearchKey<unsigned long>  { };
+template<> struct TSimdSearchKey<LONGLONG>       : public TIntegralSearchKey<LONGLONG>       { };
+template<> struct TSimdSearchKey<ULONGLONG>      : public TIntegralSearchKey<ULONGLONG>      { };
+
+#ifdef _NATIVE_WCHAR_T_DEFINED
+template<> struct TSimdSearchKey<wchar_t>        : public TIntegralSearchKey<wchar_t>        { };
+#endif
+
+template<class T> struct TSimdSearchKey<T*>
+{
+	enum { IS_SEARCHABLE = true };
+
+	static ULONGLONG Bits(T* Item)
+	{
+		return reinterpret_cast<UINT_PTR>(Item);
+	}
+};
+
+/******************************************************************************
+**
+** The class used to search buffers of 8, 16, 32 or 64-bit items for a value.
+** The fastest implementation supported by the CPU is selected at runtime,
+** i.e. AVX2, SSE2 or a scalar loop.
+**
+*******************************************************************************
+*/
+
+class CSimdSearch
+{
+public:
+	//
+	// Methods.
+	//
+	static size_t Find(const void* pItems, size_t nCount, size_t nItemSize, ULONGLONG nValue);
+	static size_t FindLast(const void* pItems, size_t nCount, size_t nItemSize, ULONGLONG nValue);
+	static size_t Count(const void* pItems, size_t nCount, size_t nItemSize, ULONGLONG nValue);
+};
+
+#endif // SIMDSEARCH_HPP
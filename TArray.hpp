@@ -17,10 +17,21 @@
 #endif
 
 #include "Array.hpp"
+#include "TypeTraits.hpp"
+#include "RadixSort.hpp"
+#include "ParallelSort.hpp"
+#include "SimdSearch.hpp"
+#include "TSpan.hpp"
+#include <algorithm>
+#include <functional>
+#include <stdlib.h>
+#include <new>
 
 /******************************************************************************
 **
-** This is a template class used for arrays of primitive types.
+** This is a template class used for arrays of values. Trivially copyable types
+** are copied and moved bytewise, all other types are copy or move constructed
+** in place and destroyed when removed.
 **
 *******************************************************************************
 */
@@ -35,6 +46,10 @@ public:
 	// Constructors/Destructor.
 	//
 	TArray();
+	explicit TArray(GrowthPolicy eGrowth, size_t nGrowBy = DEF_GROW_BY);
+	explicit TArray(CArrayAllocator& oAllocator);
+	TArray(const TArray<T>& oArray);
+	TArray(const T* pFirst, const T* pLast);
 	virtual ~TArray();
 
 	//
@@ -42,6 +57,12 @@ public:
 	//
 	size_t Size() const;
 
+	size_t Capacity() const;
+	void Reserve(size_t nSize);
+	void ShrinkToFit();
+	void SetGrowthPolicy(GrowthPolicy eGrowth, size_t nGrowBy = DEF_GROW_BY);
+	void SetAllocator(CArrayAllocator* pAllocator);
+
 	T At(size_t nIndex) const;
 	T operator[](size_t nIndex) const;
 
@@ -49,14 +70,71 @@ public:
 	size_t Add(T Item);
 	void Insert(size_t nIndex, T Item);
 
+#ifdef LEGACY_HAS_CXX11
+	template<class... A>
+	size_t Emplace(A&&... Args);
+#else
+	size_t Emplace();
+	template<class A1>
+	size_t Emplace(const A1& Arg1);
+	template<class A1, class A2>
+	size_t Emplace(const A1& Arg1, const A2& Arg2);
+	template<class A1, class A2, class A3>
+	size_t Emplace(const A1& Arg1, const A2& Arg2, const A3& Arg3);
+#endif
+
+	size_t AddRange(const T* pItems, size_t nCount);
+	size_t AddRange(const TArray<T>& oArray);
+	void InsertRange(size_t nIndex, const T* pFirst, const T* pLast);
+	void InsertRange(size_t nIndex, const TArray<T>& oArray);
+
 	void Remove(size_t nIndex);
+	void RemoveRange(size_t nIndex, size_t nCount);
 	void RemoveAll();
 
+	template<class P>
+	size_t RemoveIf(P oPredicate);
+
 	size_t Find(T Item) const;
+	size_t FindLast(T Item) const;
+	size_t Count(T Item) const;
+	size_t FindAll(T Item, TArray<size_t>& vIndices) const;
 	void Swap(size_t nIndex1, size_t nIndex2);
 
 	void Sort(PFNCOMPARE pfnCompare);
 
+	void Sort();
+	template<class C>
+	void Sort(C oLess);
+
+	void StableSort();
+	template<class C>
+	void StableSort(C oLess);
+
+	void RadixSort();
+	template<class K>
+	void RadixSort(K oKey);
+
+	void ParallelSort();
+	template<class C>
+	void ParallelSort(C oLess, size_t nThreads = 0);
+
+	void PartialSort(size_t nCount);
+	template<class C>
+	void PartialSort(size_t nCount, C oLess);
+
+	void NthElement(size_t nIndex);
+	template<class C>
+	void NthElement(size_t nIndex, C oLess);
+
+	bool Save(const tchar* pszPath, uint nTypeTag = 0) const;
+
+	void Attach(T* pItems, size_t nSize, size_t nCapacity);
+	T* Detach(size_t& nSize, size_t& nCapacity);
+
+	TSpan<T> Span();
+	TSpan<const T> Span() const;
+
 	//
 	// std::vector compatibility types and methods.
 	//
@@ -71,9 +149,44 @@ public:
 	iterator begin();
 	iterator end();
 
+protected:
+	//
+	// Derived class constructors.
+	//
+	TArray(void* pInline, size_t nInlineSize);
+
 private:
-	// Disallow copies for now.
-	TArray(const TArray<T>&);
+	// Selects the bytewise or per-item implementation.
+	typedef typename TIsTrivial<T>::Type IsTrivial;
+
+	// Selects the SIMD or per-item search implementation.
+	typedef TBoolType<TSimdSearchKey<T>::IS_SEARCHABLE> IsSearchable;
+
+	//
+	// Internal methods.
+	//
+	void InsertItem(size_t nIndex, T& Item, TrueType);
+	void InsertItem(size_t nIndex, T& Item, FalseType);
+	void InsertItems(size_t nIndex, const T* pItems, size_t nCount, TrueType);
+	void InsertItems(size_t nIndex, const T* pItems, size_t nCount, FalseType);
+	void RemoveItems(size_t nIndex, size_t nCount, TrueType);
+	void RemoveItems(size_t nIndex, size_t nCount, FalseType);
+	void DestroyItems(TrueType);
+	void DestroyItems(FalseType);
+	size_t FindItem(size_t nFirst, T Item, TrueType) const;
+	size_t FindItem(size_t nFirst, T Item, FalseType) const;
+	size_t FindLastItem(T Item, TrueType) const;
+	size_t FindLastItem(T Item, FalseType) const;
+	size_t CountItems(T Item, TrueType) const;
+	size_t CountItems(T Item, FalseType) const;
+	void CopyItems(const TArray<T>& oArray, TrueType);
+	void CopyItems(const TArray<T>& oArray, FalseType);
+
+	static PFNRELOCATE Relocator(TrueType);
+	static PFNRELOCATE Relocator(FalseType);
+	static void RelocateItems(void* pDst, void* pSrc, size_t nCount);
+
+	// Disallow assignment for now.
 	void operator=(const TArray<T>&);
 };
 
@@ -81,12 +194,23 @@ private:
 **
 ** This is a TArray based class used for arrays of pointers to objects.
 **
+** The copies made by DeepCopy(COPY_SLAB) are owned by the array, unlike the
+** other items. They are destroyed when deleted or removed, or when the array
+** is destroyed, and so must not be shared with another array or detached.
+**
 *******************************************************************************
 */
 
 template<class T> class TPtrArray : public TArray<T*>
 {
 public:
+	// The ways of allocating deep copies.
+	enum CopyMode
+	{
+		COPY_HEAP,		// Allocate each copy with new.
+		COPY_SLAB		// Construct the copies in one block owned by the array.
+	};
+
 	//
 	// Constructors/Destructor.
 	//
@@ -96,13 +220,53 @@ public:
 	//
 	// Methods.
 	//
+	void Set(size_t nIndex, T* pItem);
+
+	void Remove(size_t nIndex);
+	void RemoveRange(size_t nIndex, size_t nCount);
+	void RemoveAll();
+
+	template<class P>
+	size_t RemoveIf(P oPredicate);
+
+	void Attach(T** pItems, size_t nSize, size_t nCapacity);
+	T** Detach(size_t& nSize, size_t& nCapacity);
+
 	void Delete(size_t nIndex);
+	void DeleteRange(size_t nIndex, size_t nCount);
 	void DeleteAll();
 
+	template<class P>
+	size_t DeleteIf(P oPredicate);
+
 	void ShallowCopy(const TPtrArray<T>& oRHS);
-	void DeepCopy   (const TPtrArray<T>& oRHS);
+	void DeepCopy   (const TPtrArray<T>& oRHS, CopyMode eMode = COPY_HEAP);
 
 private:
+	// A block of items allocated by DeepCopy().
+	struct Slab
+	{
+		T*		m_pItems;	//!< The first item.
+		size_t	m_nCount;	//!< The number of items.
+	};
+
+	//
+	// Members.
+	//
+	TArray<Slab>	m_vSlabs;	//!< The blocks of items owned by the array.
+
+	//
+	// Internal methods.
+	//
+	bool IsSlabItem(const T* pItem) const;
+	void ReleaseItem(T* pItem);
+	void DeleteItem(T* pItem);
+	void ReleaseRange(size_t nIndex, size_t nCount);
+	void FreeSlabs();
+
+	template<class P>
+	size_t Compact(P oPredicate, bool bDelete);
+
 	// Disallow copies for now.
 	TPtrArray(const TPtrArray<T>&);
 	void operator=(const TPtrArray<T>&);
@@ -145,6 +309,29 @@ private:
 	void operator=(const TRefArray<T>&);
 };
 
+/******************************************************************************
+**
+** The adapter used to sort with a qsort() style compare function.
+**
+*******************************************************************************
+*/
+
+template<class T> struct TCompareAdapter
+{
+	typedef int (*PFNCOMPARE)(const T* pItem1, const T* pItem2);
+
+	TCompareAdapter(PFNCOMPARE pfnCompare)
+		: m_pfnCompare(pfnCompare)
+	{ }
+
+	bool operator()(const T& Item1, const T& Item2) const
+	{
+		return (m_pfnCompare(&Item1, &Item2) < 0);
+	}
+
+	PFNCOMPARE	m_pfnCompare;
+};
+
 /******************************************************************************
 **
 ** Implementation of TArray inline functions.
@@ -155,10 +342,59 @@ private:
 template<class T> inline TArray<T>::TArray()
 	: CArray(sizeof(T))
 {
+	m_pfnRelocate = Relocator(IsTrivial());
+}
+
+template<class T> inline TArray<T>::TArray(GrowthPolicy eGrowth, size_t nGrowBy)
+	: CArray(sizeof(T), eGrowth, nGrowBy)
+{
+	m_pfnRelocate = Relocator(IsTrivial());
+}
+
+template<class T> inline TArray<T>::TArray(CArrayAllocator& oAllocator)
+	: CArray(sizeof(T))
+{
+	m_pfnRelocate = Relocator(IsTrivial());
+
+	CArray::SetAllocator(&oAllocator);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Copy the array. Trivially copyable items are shared with the other array
+// until either is modified, which makes passing arrays by value O(1).
+
+template<class T> inline TArray<T>::TArray(const TArray<T>& oArray)
+	: CArray(sizeof(T), oArray.m_eGrowth, oArray.m_nGrowBy)
+{
+	m_pfnRelocate = Relocator(IsTrivial());
+
+	CopyItems(oArray, IsTrivial());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Copy a range of items, e.g. from a std::vector. The buffer is allocated once
+// and trivially copyable items are copied with a single memcpy().
+
+template<class T> inline TArray<T>::TArray(const T* pFirst, const T* pLast)
+	: CArray(sizeof(T))
+{
+	ASSERT(pFirst <= pLast);
+
+	m_pfnRelocate = Relocator(IsTrivial());
+
+	Reserve(pLast - pFirst);
+	InsertItems(0, pFirst, pLast - pFirst, IsTrivial());
+}
+
+template<class T> inline TArray<T>::TArray(void* pInline, size_t nInlineSize)
+	: CArray(sizeof(T), pInline, nInlineSize)
+{
+	m_pfnRelocate = Relocator(IsTrivial());
 }
 
 template<class T> inline TArray<T>::~TArray()
 {
+	DestroyItems(IsTrivial());
 }
 
 template<class T> inline size_t TArray<T>::Size() const
@@ -166,6 +402,31 @@ template<class T> inline size_t TArray<T>::Size() const
 	return CArray::Size();
 }
 
+template<class T> inline size_t TArray<T>::Capacity() const
+{
+	return CArray::Capacity();
+}
+
+template<class T> inline void TArray<T>::Reserve(size_t nSize)
+{
+	CArray::Reserve(nSize);
+}
+
+template<class T> inline void TArray<T>::ShrinkToFit()
+{
+	CArray::ShrinkToFit();
+}
+
+template<class T> inline void TArray<T>::SetGrowthPolicy(GrowthPolicy eGrowth, size_t nGrowBy)
+{
+	CArray::SetGrowthPolicy(eGrowth, nGrowBy);
+}
+
+template<class T> inline void TArray<T>::SetAllocator(CArrayAllocator* pAllocator)
+{
+	CArray::SetAllocator(pAllocator);
+}
+
 template<class T> inline T TArray<T>::At(size_t nIndex) const
 {
 	return *(static_cast<T*>(CArray::At(nIndex)));
@@ -178,52 +439,389 @@ template<class T> inline T TArray<T>::operator[](size_t nIndex) const
 
 template<class T> inline void TArray<T>::Set(size_t nIndex, T Item)
 {
-	CArray::Set(nIndex, &Item);
+	Unshare();
+
+	*(static_cast<T*>(CArray::At(nIndex))) = MoveItem(Item);
 }
 
 template<class T> inline size_t TArray<T>::Add(T Item)
 {
-	return CArray::Add(&Item);
+	Unshare();
+	Grow(m_nSize+1);
+
+	new(m_pData + (m_nSize * sizeof(T))) T(MoveItem(Item));
+
+	return m_nSize++;
 }
 
 template<class T> inline void TArray<T>::Insert(size_t nIndex, T Item)
 {
-	CArray::Insert(nIndex, &Item);
+	InsertItem(nIndex, Item, IsTrivial());
+}
+
+#ifdef LEGACY_HAS_CXX11
+
+////////////////////////////////////////////////////////////////////////////////
+// Append an item constructed in place from the arguments.
+
+template<class T> template<class... A>
+inline size_t TArray<T>::Emplace(A&&... Args)
+{
+	Unshare();
+
+	// Growing would invalidate any arguments which refer to our items.
+	if (m_nSize == m_nAllocSize)
+		return Add(T(std::forward<A>(Args)...));
+
+	new(m_pData + (m_nSize * sizeof(T))) T(std::forward<A>(Args)...);
+
+	return m_nSize++;
+}
+
+#else
+
+////////////////////////////////////////////////////////////////////////////////
+// Append an item constructed in place from the arguments.
+
+template<class T> inline size_t TArray<T>::Emplace()
+{
+	Unshare();
+	Grow(m_nSize+1);
+
+	new(m_pData + (m_nSize * sizeof(T))) T();
+
+	return m_nSize++;
+}
+
+template<class T> template<class A1>
+inline size_t TArray<T>::Emplace(const A1& Arg1)
+{
+	Unshare();
+
+	// Growing would invalidate any arguments which refer to our items.
+	if (m_nSize == m_nAllocSize)
+		return Add(T(Arg1));
+
+	new(m_pData + (m_nSize * sizeof(T))) T(Arg1);
+
+	return m_nSize++;
+}
+
+template<class T> template<class A1, class A2>
+inline size_t TArray<T>::Emplace(const A1& Arg1, const A2& Arg2)
+{
+	Unshare();
+
+	// Growing would invalidate any arguments which refer to our items.
+	if (m_nSize == m_nAllocSize)
+		return Add(T(Arg1, Arg2));
+
+	new(m_pData + (m_nSize * sizeof(T))) T(Arg1, Arg2);
+
+	return m_nSize++;
+}
+
+template<class T> template<class A1, class A2, class A3>
+inline size_t TArray<T>::Emplace(const A1& Arg1, const A2& Arg2, const A3& Arg3)
+{
+	Unshare();
+
+	// Growing would invalidate any arguments which refer to our items.
+	if (m_nSize == m_nAllocSize)
+		return Add(T(Arg1, Arg2, Arg3));
+
+	new(m_pData + (m_nSize * sizeof(T))) T(Arg1, Arg2, Arg3);
+
+	return m_nSize++;
+}
+
+#endif
+
+template<class T> inline size_t TArray<T>::AddRange(const T* pItems, size_t nCount)
+{
+	size_t nIndex = m_nSize;
+
+	InsertItems(nIndex, pItems, nCount, IsTrivial());
+
+	return nIndex;
+}
+
+template<class T> inline size_t TArray<T>::AddRange(const TArray<T>& oArray)
+{
+	return AddRange(oArray.begin(), oArray.Size());
+}
+
+template<class T> inline void TArray<T>::InsertRange(size_t nIndex, const T* pFirst, const T* pLast)
+{
+	ASSERT(pFirst <= pLast);
+
+	InsertItems(nIndex, pFirst, pLast - pFirst, IsTrivial());
+}
+
+template<class T> inline void TArray<T>::InsertRange(size_t nIndex, const TArray<T>& oArray)
+{
+	InsertItems(nIndex, oArray.begin(), oArray.Size(), IsTrivial());
 }
 
 template<class T> inline void TArray<T>::Remove(size_t nIndex)
 {
-	CArray::Remove(nIndex);
+	ASSERT(nIndex < m_nSize);
+
+	RemoveItems(nIndex, 1, IsTrivial());
+}
+
+template<class T> inline void TArray<T>::RemoveRange(size_t nIndex, size_t nCount)
+{
+	RemoveItems(nIndex, nCount, IsTrivial());
 }
 
 template<class T> inline void TArray<T>::RemoveAll()
 {
+	DestroyItems(IsTrivial());
+
 	CArray::RemoveAll();
 }
 
+template<class T> template<class P>
+inline size_t TArray<T>::RemoveIf(P oPredicate)
+{
+	// Compact the survivors in a single pass.
+	iterator itEnd = std::remove_if(begin(), end(), oPredicate);
+
+	size_t nFirst = itEnd - begin();
+	size_t nCount = Size() - nFirst;
+
+	RemoveItems(nFirst, nCount, IsTrivial());
+
+	return nCount;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Find the first item equal to the value. Integral and pointer types use the
+// SIMD search, all other types compare each item in turn.
+
 template<class T> inline size_t TArray<T>::Find(T Item) const
 {
-	for (size_t i = 0; i < Size(); ++i)
+	return FindItem(0, Item, IsSearchable());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Find the last item equal to the value.
+
+template<class T> inline size_t TArray<T>::FindLast(T Item) const
+{
+	return FindLastItem(Item, IsSearchable());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Count the items equal to the value.
+
+template<class T> inline size_t TArray<T>::Count(T Item) const
+{
+	return CountItems(Item, IsSearchable());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Append the indices of all the items equal to the value.
+
+template<class T>
+inline size_t TArray<T>::FindAll(T Item, TArray<size_t>& vIndices) const
+{
+	size_t nFound = 0;
+	size_t nIndex = FindItem(0, Item, IsSearchable());
+
+	while (nIndex != Core::npos)
 	{
-		if (At(i) == Item)
-			return i;
+		vIndices.Add(nIndex);
+		++nFound;
+
+		nIndex = FindItem(nIndex+1, Item, IsSearchable());
 	}
 
-	return Core::npos;
+	return nFound;
 }
 
 template<class T> inline void TArray<T>::Swap(size_t nIndex1, size_t nIndex2)
 {
-	T Item1 = At(nIndex1);
-	T Item2 = At(nIndex2);
+	Unshare();
 
-	Set(nIndex1, Item2);
-	Set(nIndex2, Item1);
+	std::swap(*(static_cast<T*>(CArray::At(nIndex1))), *(static_cast<T*>(CArray::At(nIndex2))));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Sort the array using a qsort() style compare function.
+
 template<class T> inline void TArray<T>::Sort(PFNCOMPARE pfnCompare)
 {
-	CArray::Sort(pfnCompare);
+	std::sort(begin(), end(), TCompareAdapter<T>(pfnCompare));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Sort the array into ascending order. Arithmetic and pointer types use a radix
+// sort, all other types use operator<. NB: Unlike the PFNCOMPARE version the
+// comparison is inlined.
+
+template<class T> inline void TArray<T>::Sort()
+{
+	DefaultSort(begin(), Size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Sort the array using a "less than" predicate, e.g. a functor or lambda.
+
+template<class T> template<class C>
+inline void TArray<T>::Sort(C oLess)
+{
+	std::sort(begin(), end(), oLess);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Sort the array using operator< whilst preserving the order of equal items.
+
+template<class T> inline void TArray<T>::StableSort()
+{
+	std::stable_sort(begin(), end());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Sort the array using a "less than" predicate whilst preserving the order of
+// equal items.
+
+template<class T> template<class C>
+inline void TArray<T>::StableSort(C oLess)
+{
+	std::stable_sort(begin(), end(), oLess);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Sort the array of arithmetic or pointer types using a radix sort.
+
+template<class T> inline void TArray<T>::RadixSort()
+{
+	(void)sizeof(TStaticAssert<TIsTrivial<T>::VALUE>);
+
+	::RadixSort(begin(), Size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Sort the array using a radix sort on the integer key returned by the key
+// extractor. This is either a function, a functor with a result_type or, with
+// C++11, any callable such as a lambda.
+
+template<class T> template<class K>
+inline void TArray<T>::RadixSort(K oKey)
+{
+	(void)sizeof(TStaticAssert<TIsTrivial<T>::VALUE>);
+
+	::RadixSort(begin(), Size(), TRadixKeyAdapter<K, T>(oKey));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Sort the array in place using operator< with one thread per processor.
+
+template<class T> inline void TArray<T>::ParallelSort()
+{
+	::ParallelSort(begin(), Size(), std::less<T>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Sort the array in place using a "less than" predicate and the given number of
+// threads. A thread count of 0 uses one thread per processor. Small arrays are
+// sorted on the calling thread.
+
+template<class T> template<class C>
+inline void TArray<T>::ParallelSort(C oLess, size_t nThreads)
+{
+	::ParallelSort(begin(), Size(), oLess, nThreads);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Sort only the first nCount items into ascending order using operator<. The
+// order of the remaining items is unspecified. This is O(n log k) rather than
+// O(n log n).
+
+template<class T> inline void TArray<T>::PartialSort(size_t nCount)
+{
+	PartialSort(nCount, std::less<T>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Sort only the first nCount items using a "less than" predicate.
+
+template<class T> template<class C>
+inline void TArray<T>::PartialSort(size_t nCount, C oLess)
+{
+	ASSERT(nCount <= Size());
+
+	std::partial_sort(begin(), begin() + nCount, end(), oLess);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Move the item that would be at the index if the array was sorted using
+// operator< into place, with no greater items before it and no lesser items
+// after it, e.g. to find the median. This is O(n) on average.
+
+template<class T> inline void TArray<T>::NthElement(size_t nIndex)
+{
+	NthElement(nIndex, std::less<T>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Move the nth item into place using a "less than" predicate.
+
+template<class T> template<class C>
+inline void TArray<T>::NthElement(size_t nIndex, C oLess)
+{
+	ASSERT(nIndex < Size());
+
+	std::nth_element(begin(), begin() + nIndex, end(), oLess);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Save the items to a file which can be mapped with a TArrayView. The type
+// tag is checked when the file is opened. NB: Only for trivially copyable
+// types.
+
+template<class T>
+inline bool TArray<T>::Save(const tchar* pszPath, uint nTypeTag) const
+{
+	(void)sizeof(TStaticAssert<TIsTrivial<T>::VALUE>);
+
+	return CArray::Save(pszPath, nTypeTag);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Take ownership of a buffer of constructed items, destroying the current ones,
+// e.g. one released by another array. NB: The buffer must have been allocated
+// by the array's allocator, i.e. with malloc() or realloc() if it has none.
+
+template<class T> inline void TArray<T>::Attach(T* pItems, size_t nSize, size_t nCapacity)
+{
+	RemoveAll();
+
+	CArray::Attach(reinterpret_cast<byte*>(pItems), nSize, nCapacity);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Give up ownership of the buffer, leaving the array empty. The caller must
+// destroy the items and free the buffer with the array's allocator.
+
+template<class T> inline T* TArray<T>::Detach(size_t& nSize, size_t& nCapacity)
+{
+	return reinterpret_cast<T*>(CArray::Detach(nSize, nCapacity));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Get a view of the items, which is invalidated by any change to the size.
+
+template<class T> inline TSpan<T> TArray<T>::Span()
+{
+	return TSpan<T>(begin(), Size());
+}
+
+template<class T> inline TSpan<const T> TArray<T>::Span() const
+{
+	return TSpan<const T>(begin(), Size());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -254,6 +852,8 @@ inline typename TArray<T>::const_iterator TArray<T>::end() const
 template<class T>
 inline typename TArray<T>::iterator TArray<T>::begin()
 {
+	Unshare();
+
 	T* base = reinterpret_cast<T*>(m_pData);
 
 	return base;
@@ -262,11 +862,197 @@ inline typename TArray<T>::iterator TArray<T>::begin()
 template<class T>
 inline typename TArray<T>::iterator TArray<T>::end()
 {
+	Unshare();
+
 	T* base = reinterpret_cast<T*>(m_pData);
 
 	return (base+m_nSize);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Internal methods.
+
+template<class T>
+inline void TArray<T>::InsertItem(size_t nIndex, T& Item, TrueType)
+{
+	CArray::Insert(nIndex, &Item);
+}
+
+template<class T>
+inline void TArray<T>::InsertItem(size_t nIndex, T& Item, FalseType)
+{
+	ASSERT(nIndex <= m_nSize);
+
+	// Construct at the end and rotate into position.
+	Add(MoveItem(Item));
+
+	std::rotate(begin()+nIndex, end()-1, end());
+}
+
+template<class T>
+inline void TArray<T>::InsertItems(size_t nIndex, const T* pItems, size_t nCount, TrueType)
+{
+	CArray::InsertRange(nIndex, pItems, nCount);
+}
+
+template<class T>
+inline void TArray<T>::InsertItems(size_t nIndex, const T* pItems, size_t nCount, FalseType)
+{
+	ASSERT(nIndex <= m_nSize);
+	ASSERT((pItems != NULL) || (nCount == 0));
+
+	// Inserting items from our own buffer?
+	if ( (pItems >= begin()) && (pItems < end()) )
+	{
+		// Take a copy as growing the buffer will invalidate them.
+		TArray<T> oCopy;
+
+		oCopy.InsertItems(0, pItems, nCount, FalseType());
+		InsertItems(nIndex, oCopy.begin(), nCount, FalseType());
+		return;
+	}
+
+	Grow(m_nSize+nCount);
+
+	// Construct at the end and rotate into position.
+	std::uninitialized_copy(pItems, pItems+nCount, end());
+
+	m_nSize += nCount;
+
+	std::rotate(begin()+nIndex, end()-nCount, end());
+}
+
+template<class T>
+inline void TArray<T>::RemoveItems(size_t nIndex, size_t nCount, TrueType)
+{
+	CArray::RemoveRange(nIndex, nCount);
+}
+
+template<class T>
+inline void TArray<T>::RemoveItems(size_t nIndex, size_t nCount, FalseType)
+{
+	ASSERT(nIndex <= m_nSize);
+	ASSERT(nCount <= (m_nSize - nIndex));
+
+	T* pItems = begin();
+
+	// Move all following items down.
+	for (size_t i = nIndex; i != (m_nSize - nCount); ++i)
+		pItems[i] = MoveItem(pItems[i+nCount]);
+
+	// Destroy the vacated items at the end.
+	for (size_t i = (m_nSize - nCount); i != m_nSize; ++i)
+		pItems[i].~T();
+
+	m_nSize -= nCount;
+}
+
+template<class T>
+inline void TArray<T>::DestroyItems(TrueType)
+{
+}
+
+template<class T>
+inline void TArray<T>::DestroyItems(FalseType)
+{
+	for (iterator it = begin(); it != end(); ++it)
+		it->~T();
+
+	m_nSize = 0;
+}
+
+template<class T>
+inline void TArray<T>::CopyItems(const TArray<T>& oArray, TrueType)
+{
+	CArray::Share(oArray);
+}
+
+template<class T>
+inline void TArray<T>::CopyItems(const TArray<T>& oArray, FalseType)
+{
+	CArray::SetAllocator(oArray.m_pAllocator);
+
+	AddRange(oArray);
+}
+
+template<class T>
+inline size_t TArray<T>::FindItem(size_t nFirst, T Item, TrueType) const
+{
+	size_t nIndex = CSimdSearch::Find(begin() + nFirst, m_nSize - nFirst, sizeof(T), TSimdSearchKey<T>::Bits(Item));
+
+	return (nIndex != Core::npos) ? (nFirst + nIndex) : Core::npos;
+}
+
+template<class T>
+inline size_t TArray<T>::FindItem(size_t nFirst, T Item, FalseType) const
+{
+	for (const_iterator it = begin() + nFirst; it != end(); ++it)
+	{
+		if (*it == Item)
+			return it - begin();
+	}
+
+	return Core::npos;
+}
+
+template<class T>
+inline size_t TArray<T>::FindLastItem(T Item, TrueType) const
+{
+	return CSimdSearch::FindLast(begin(), m_nSize, sizeof(T), TSimdSearchKey<T>::Bits(Item));
+}
+
+template<class T>
+inline size_t TArray<T>::FindLastItem(T Item, FalseType) const
+{
+	for (const_iterator it = end(); it != begin(); --it)
+	{
+		if (*(it-1) == Item)
+			return (it-1) - begin();
+	}
+
+	return Core::npos;
+}
+
+template<class T>
+inline size_t TArray<T>::CountItems(T Item, TrueType) const
+{
+	return CSimdSearch::Count(begin(), m_nSize, sizeof(T), TSimdSearchKey<T>::Bits(Item));
+}
+
+template<class T>
+inline size_t TArray<T>::CountItems(T Item, FalseType) const
+{
+	return std::count(begin(), end(), Item);
+}
+
+template<class T>
+inline typename TArray<T>::PFNRELOCATE TArray<T>::Relocator(TrueType)
+{
+	return NULL;
+}
+
+template<class T>
+inline typename TArray<T>::PFNRELOCATE TArray<T>::Relocator(FalseType)
+{
+	return RelocateItems;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// The callback used by CArray to move items to a new buffer.
+
+template<class T>
+inline void TArray<T>::RelocateItems(void* pDst, void* pSrc, size_t nCount)
+{
+	T* pDstItems = static_cast<T*>(pDst);
+	T* pSrcItems = static_cast<T*>(pSrc);
+
+	for (size_t i = 0; i != nCount; ++i)
+	{
+		new(pDstItems+i) T(MoveItem(pSrcItems[i]));
+		pSrcItems[i].~T();
+	}
+}
+
 /******************************************************************************
 **
 ** Implementation of TPtrArray inline functions.
@@ -280,38 +1066,250 @@ template<class T> inline TPtrArray<T>::TPtrArray()
 
 template<class T> inline TPtrArray<T>::~TPtrArray()
 {
+	ReleaseRange(0, Base::Size());
+	FreeSlabs();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Replace an item. NB: Only a slab item that is replaced is destroyed.
+
+template<class T> inline void TPtrArray<T>::Set(size_t nIndex, T* pItem)
+{
+	T* pOldItem = Base::At(nIndex);
+
+	if (pOldItem != pItem)
+		ReleaseItem(pOldItem);
+
+	Base::Set(nIndex, pItem);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Remove items without deleting them. NB: Slab items are always destroyed as
+// the array owns them.
+
+template<class T> inline void TPtrArray<T>::Remove(size_t nIndex)
+{
+	RemoveRange(nIndex, 1);
+}
+
+template<class T> inline void TPtrArray<T>::RemoveRange(size_t nIndex, size_t nCount)
+{
+	ReleaseRange(nIndex, nCount);
+	Base::RemoveRange(nIndex, nCount);
+}
+
+template<class T> inline void TPtrArray<T>::RemoveAll()
+{
+	ReleaseRange(0, Base::Size());
+	Base::RemoveAll();
+
+	FreeSlabs();
+}
+
+template<class T> template<class P>
+inline size_t TPtrArray<T>::RemoveIf(P oPredicate)
+{
+	return Compact(oPredicate, false);
+}
+
+template<class T> inline void TPtrArray<T>::Attach(T** pItems, size_t nSize, size_t nCapacity)
+{
+	RemoveAll();
+
+	Base::Attach(pItems, nSize, nCapacity);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Give up ownership of the buffer. NB: Not allowed when there are slab items,
+// as they would be freed with the array.
+
+template<class T> inline T** TPtrArray<T>::Detach(size_t& nSize, size_t& nCapacity)
+{
+	ASSERT(m_vSlabs.Size() == 0);
+
+	return Base::Detach(nSize, nCapacity);
 }
 
 template<class T> inline void TPtrArray<T>::Delete(size_t nIndex)
 {
-	delete Base::At(nIndex);
+	DeleteItem(Base::At(nIndex));
 	Base::Remove(nIndex);
 }
 
+template<class T> inline void TPtrArray<T>::DeleteRange(size_t nIndex, size_t nCount)
+{
+	ASSERT(nIndex <= Base::Size());
+	ASSERT(nCount <= (Base::Size() - nIndex));
+
+	for (size_t i = nIndex; i < (nIndex + nCount); ++i)
+		DeleteItem(Base::At(i));
+
+	Base::RemoveRange(nIndex, nCount);
+}
+
+template<class T> template<class P>
+inline size_t TPtrArray<T>::DeleteIf(P oPredicate)
+{
+	return Compact(oPredicate, true);
+}
+
 template<class T> inline void TPtrArray<T>::DeleteAll()
 {
 	for (size_t i = 0; i < Base::Size(); ++i)
-		delete Base::At(i);
+		DeleteItem(Base::At(i));
 
 	Base::RemoveAll();
+
+	FreeSlabs();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Append the pointers to the items. NB: The items must not be slab items as
+// they would be destroyed with the other array.
+
 template<class T> inline void TPtrArray<T>::ShallowCopy(const TPtrArray<T>& oRHS)
 {
+	ASSERT(oRHS.m_vSlabs.Size() == 0);
+
 	this->Reserve(oRHS.Size());
 
 	for (size_t i = 0; i < oRHS.Size(); ++i)
 		this->Add(oRHS.At(i));
 }
 
-template<class T> inline void TPtrArray<T>::DeepCopy(const TPtrArray<T>& oRHS)
+////////////////////////////////////////////////////////////////////////////////
+// Append copies of the items. The slab mode allocates the copies together in a
+// single block, which is faster and keeps them contiguous.
+
+template<class T> inline void TPtrArray<T>::DeepCopy(const TPtrArray<T>& oRHS, CopyMode eMode)
 {
-	this->Reserve(oRHS.Size());
+	this->Reserve(this->Size() + oRHS.Size());
+
+	if ( (eMode == COPY_HEAP) || (oRHS.Size() == 0) )
+	{
+		for (size_t i = 0; i < oRHS.Size(); ++i)
+		{
+			this->Add(new T(*oRHS.At(i)));
+		}
+
+		return;
+	}
+
+	Slab oSlab;
+
+	oSlab.m_pItems = static_cast<T*>(malloc(oRHS.Size() * sizeof(T)));
+	oSlab.m_nCount = oRHS.Size();
+	ASSERT(oSlab.m_pItems);
+
+	// Keep the slabs in address order for IsSlabItem().
+	size_t nSlab = 0;
+
+	while ( (nSlab < m_vSlabs.Size()) && (std::less<const T*>()(m_vSlabs[nSlab].m_pItems, oSlab.m_pItems)) )
+		++nSlab;
+
+	m_vSlabs.Insert(nSlab, oSlab);
 
 	for (size_t i = 0; i < oRHS.Size(); ++i)
+		this->Add(new(oSlab.m_pItems + i) T(*oRHS.At(i)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Query if the item was allocated in one of the slabs, with a binary search of
+// the slabs by address.
+
+template<class T> inline bool TPtrArray<T>::IsSlabItem(const T* pItem) const
+{
+	std::less<const T*> oLess;
+
+	const Slab* pSlabs = m_vSlabs.begin();
+	size_t      nFirst = 0;
+	size_t      nLast  = m_vSlabs.Size();
+
+	// Find the first slab which starts after the item.
+	while (nFirst != nLast)
+	{
+		size_t nMiddle = nFirst + ((nLast - nFirst) / 2);
+
+		if (oLess(pItem, pSlabs[nMiddle].m_pItems))
+			nLast = nMiddle;
+		else
+			nFirst = nMiddle + 1;
+	}
+
+	if (nFirst == 0)
+		return false;
+
+	const Slab& oSlab = pSlabs[nFirst-1];
+
+	return oLess(pItem, oSlab.m_pItems + oSlab.m_nCount);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Destroy an item being removed if it is a slab item, as the memory is freed
+// with the slab.
+
+template<class T> inline void TPtrArray<T>::ReleaseItem(T* pItem)
+{
+	if ( (m_vSlabs.Size() != 0) && (IsSlabItem(pItem)) )
+		pItem->~T();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Delete an item. Slab items are only destroyed.
+
+template<class T> inline void TPtrArray<T>::DeleteItem(T* pItem)
+{
+	if ( (m_vSlabs.Size() != 0) && (IsSlabItem(pItem)) )
+		pItem->~T();
+	else
+		delete pItem;
+}
+
+template<class T> inline void TPtrArray<T>::ReleaseRange(size_t nIndex, size_t nCount)
+{
+	ASSERT(nIndex <= Base::Size());
+	ASSERT(nCount <= (Base::Size() - nIndex));
+
+	if (m_vSlabs.Size() == 0)
+		return;
+
+	for (size_t i = nIndex; i != (nIndex + nCount); ++i)
+		ReleaseItem(Base::At(i));
+}
+
+template<class T> inline void TPtrArray<T>::FreeSlabs()
+{
+	for (size_t i = 0; i < m_vSlabs.Size(); ++i)
+		free(m_vSlabs[i].m_pItems);
+
+	m_vSlabs.RemoveAll();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Remove the matching items and compact the survivors in a single pass. The
+// matches are either deleted or, for slab items, destroyed.
+
+template<class T> template<class P>
+inline size_t TPtrArray<T>::Compact(P oPredicate, bool bDelete)
+{
+	typename Base::iterator itDst = Base::begin();
+
+	for (typename Base::iterator itSrc = Base::begin(); itSrc != Base::end(); ++itSrc)
 	{
-		this->Add(new T(*oRHS.At(i)));
+		if (!oPredicate(*itSrc))
+			*itDst++ = *itSrc;
+		else if (bDelete)
+			DeleteItem(*itSrc);
+		else
+			ReleaseItem(*itSrc);
 	}
+
+	size_t nFirst = itDst - Base::begin();
+	size_t nCount = Base::Size() - nFirst;
+
+	Base::RemoveRange(nFirst, nCount);
+
+	return nCount;
 }
 
 /******************************************************************************
@@ -0,0 +1,118 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		TARRAYVIEW.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The TArrayView template class declaration.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef TARRAYVIEW_HPP
+#define TARRAYVIEW_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include "ArrayView.hpp"
+#include "TypeTraits.hpp"
+
+/******************************************************************************
+**
+** This is a template class used for read-only views of arrays saved with
+** TArray::Save(). The items are accessed directly in the mapped file, so
+** opening the view doesn't copy them. NB: Only for trivially copyable types.
+**
+*******************************************************************************
+*/
+
+template<class T> class TArrayView : protected CArrayView
+{
+public:
+	//
+	// Constructors/Destructor.
+	//
+	TArrayView();
+	virtual ~TArrayView();
+
+	//
+	// Methods.
+	//
+	bool Open(const tchar* pszPath, uint nTypeTag = 0, bool bVerify = true);
+	using CArrayView::Close;
+	using CArrayView::IsOpen;
+
+	size_t Size() const;
+
+	const T& At(size_t nIndex) const;
+	const T& operator[](size_t nIndex) const;
+
+	//
+	// std::vector compatibility types and methods.
+	//
+	typedef const T* const_iterator;
+
+	size_t size() const;
+
+	const_iterator begin() const;
+	const_iterator end() const;
+};
+
+/******************************************************************************
+**
+** Implementation of TArrayView inline functions.
+**
+*******************************************************************************
+*/
+
+template<class T> inline TArrayView<T>::TArrayView()
+	: CArrayView(sizeof(T))
+{
+	(void)sizeof(TStaticAssert<TIsTrivial<T>::VALUE>);
+}
+
+template<class T> inline TArrayView<T>::~TArrayView()
+{
+}
+
+template<class T>
+inline bool TArrayView<T>::Open(const tchar* pszPath, uint nTypeTag, bool bVerify)
+{
+	return CArrayView::Open(pszPath, nTypeTag, bVerify);
+}
+
+template<class T> inline size_t TArrayView<T>::Size() const
+{
+	return CArrayView::Size();
+}
+
+template<class T> inline const T& TArrayView<T>::At(size_t nIndex) const
+{
+	return *(static_cast<const T*>(CArrayView::At(nIndex)));
+}
+
+template<class T> inline const T& TArrayView<T>::operator[](size_t nIndex) const
+{
+	return *(static_cast<const T*>(CArrayView::At(nIndex)));
+}
+
+template<class T> inline size_t TArrayView<T>::size() const
+{
+	return CArrayView::Size();
+}
+
+template<class T>
+inline typename TArrayView<T>::const_iterator TArrayView<T>::begin() const
+{
+	return reinterpret_cast<const T*>(m_pData);
+}
+
+template<class T>
+inline typename TArrayView<T>::const_iterator TArrayView<T>::end() const
+{
+	return reinterpret_cast<const T*>(m_pData) + m_nSize;
+}
+
+#endif // TARRAYVIEW_HPP
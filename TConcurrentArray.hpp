@@ -0,0 +1,120 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		TCONCURRENTARRAY.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The TConcurrentArray template class declaration.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef TCONCURRENTARRAY_HPP
+#define TCONCURRENTARRAY_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include "ConcurrentArray.hpp"
+#include "TArray.hpp"
+
+/******************************************************************************
+**
+** This is a template class used for arrays which many threads append to at
+** the same time. Once the producers have finished Seal() moves the items into
+** a TArray for single-threaded processing. NB: Only for trivially copyable
+** types.
+**
+*******************************************************************************
+*/
+
+template<class T> class TConcurrentArray : public CConcurrentArray
+{
+public:
+	//
+	// Constructors/Destructor.
+	//
+	TConcurrentArray();
+	~TConcurrentArray();
+
+	//
+	// Methods.
+	//
+	T At(size_t nIndex) const;
+	T operator[](size_t nIndex) const;
+
+	size_t Add(const T& Item);
+	size_t AddRange(const T* pItems, size_t nCount);
+	size_t AddRange(const TArray<T>& oArray);
+
+	void Seal(TArray<T>& oArray);
+};
+
+/******************************************************************************
+**
+** Implementation of TConcurrentArray inline functions.
+**
+*******************************************************************************
+*/
+
+template<class T> inline TConcurrentArray<T>::TConcurrentArray()
+	: CConcurrentArray(sizeof(T))
+{
+	(void)sizeof(TStaticAssert<TIsTrivial<T>::VALUE>);
+}
+
+template<class T> inline TConcurrentArray<T>::~TConcurrentArray()
+{
+}
+
+template<class T> inline T TConcurrentArray<T>::At(size_t nIndex) const
+{
+	return *(static_cast<const T*>(CConcurrentArray::At(nIndex)));
+}
+
+template<class T> inline T TConcurrentArray<T>::operator[](size_t nIndex) const
+{
+	return *(static_cast<const T*>(CConcurrentArray::At(nIndex)));
+}
+
+template<class T> inline size_t TConcurrentArray<T>::Add(const T& Item)
+{
+	return CConcurrentArray::Add(&Item);
+}
+
+template<class T>
+inline size_t TConcurrentArray<T>::AddRange(const T* pItems, size_t nCount)
+{
+	return CConcurrentArray::AddRange(pItems, nCount);
+}
+
+template<class T>
+inline size_t TConcurrentArray<T>::AddRange(const TArray<T>& oArray)
+{
+	return CConcurrentArray::AddRange(oArray.begin(), oArray.Size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Append the items to the array, a segment at a time, and then empty this one.
+// NB: All the producers must have finished.
+
+template<class T> inline void TConcurrentArray<T>::Seal(TArray<T>& oArray)
+{
+	oArray.Reserve(oArray.Size() + Size());
+
+	for (size_t i = 0; i != NUM_SEGMENTS; ++i)
+	{
+		size_t   nCount;
+		const T* pItems = reinterpret_cast<const T*>(Segment(i, nCount));
+
+		if (pItems == NULL)
+			break;
+
+		oArray.AddRange(pItems, nCount);
+	}
+
+	RemoveAll();
+}
+
+#endif // TCONCURRENTARRAY_HPP
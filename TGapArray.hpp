@@ -0,0 +1,467 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		TGAPARRAY.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The TGapArray template class declaration.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef TGAPARRAY_HPP
+#define TGAPARRAY_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include "TArray.hpp"
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+
+/******************************************************************************
+**
+** This is a template class with the TArray interface which is used for arrays
+** that have bursts of inserts and removes around a moving position, e.g. when
+** applying sorted edits. The unused space is kept as a gap at the position of
+** the last edit so that only the items between the old and new positions are
+** moved, rather than the entire tail.
+**
+** NB: Readers that need the items in a single contiguous block, including the
+** iterators, should call Compact() first, which moves the gap to the end.
+**
+*******************************************************************************
+*/
+
+template<class T> class TGapArray
+{
+public:
+	//
+	// Constructors/Destructor.
+	//
+	TGapArray();
+	~TGapArray();
+
+	//
+	// Methods.
+	//
+	size_t Size() const;
+
+	size_t Capacity() const;
+	void Reserve(size_t nSize);
+
+	T At(size_t nIndex) const;
+	T operator[](size_t nIndex) const;
+
+	void Set(size_t nIndex, T Item);
+	size_t Add(T Item);
+	size_t AddRange(const T* pItems, size_t nCount);
+	size_t AddRange(const TArray<T>& oArray);
+	void Insert(size_t nIndex, T Item);
+	void InsertRange(size_t nIndex, const T* pFirst, const T* pLast);
+	void InsertRange(size_t nIndex, const TArray<T>& oArray);
+
+	void Remove(size_t nIndex);
+	void RemoveRange(size_t nIndex, size_t nCount);
+	void RemoveAll();
+
+	size_t Find(T Item) const;
+
+	const T* Compact();
+
+	//
+	// std::vector compatibility types and methods.
+	//
+	typedef const T* const_iterator;
+
+	size_t size() const;
+
+	const_iterator begin() const;
+	const_iterator end() const;
+
+private:
+	// Selects the bytewise or per-item implementation.
+	typedef typename TIsTrivial<T>::Type IsTrivial;
+
+	// The smallest buffer size allocated.
+	enum { MIN_CAPACITY = 4 };
+
+	//
+	// Members.
+	//
+	T*		m_pData;		//!< The buffer.
+	size_t	m_nCapacity;	//!< The buffer size.
+	size_t	m_nGapStart;	//!< The buffer index of the gap.
+	size_t	m_nGapEnd;		//!< The buffer index of the first item after the gap.
+
+	//
+	// Internal methods.
+	//
+	size_t Slot(size_t nIndex) const;
+	void InsertItems(size_t nIndex, const T* pItems, size_t nCount);
+	void MoveGap(size_t nIndex);
+	void Grow(size_t nSize);
+	void Reallocate(size_t nCapacity);
+
+	static void MoveItems(T* pDst, T* pSrc, size_t nCount, TrueType);
+	static void MoveItems(T* pDst, T* pSrc, size_t nCount, FalseType);
+	static void CopyItems(T* pDst, const T* pSrc, size_t nCount, TrueType);
+	static void CopyItems(T* pDst, const T* pSrc, size_t nCount, FalseType);
+
+	// Disallow copies for now.
+	TGapArray(const TGapArray<T>&);
+	void operator=(const TGapArray<T>&);
+};
+
+/******************************************************************************
+**
+** Implementation of TGapArray inline functions.
+**
+*******************************************************************************
+*/
+
+template<class T> inline TGapArray<T>::TGapArray()
+	: m_pData(NULL)
+	, m_nCapacity(0)
+	, m_nGapStart(0)
+	, m_nGapEnd(0)
+{
+}
+
+template<class T> inline TGapArray<T>::~TGapArray()
+{
+	RemoveAll();
+}
+
+template<class T> inline size_t TGapArray<T>::Size() const
+{
+	return m_nCapacity - (m_nGapEnd - m_nGapStart);
+}
+
+template<class T> inline size_t TGapArray<T>::Capacity() const
+{
+	return m_nCapacity;
+}
+
+template<class T> inline void TGapArray<T>::Reserve(size_t nSize)
+{
+	if (nSize > m_nCapacity)
+		Reallocate(nSize);
+}
+
+template<class T> inline T TGapArray<T>::At(size_t nIndex) const
+{
+	ASSERT(nIndex < Size());
+
+	return m_pData[Slot(nIndex)];
+}
+
+template<class T> inline T TGapArray<T>::operator[](size_t nIndex) const
+{
+	ASSERT(nIndex < Size());
+
+	return m_pData[Slot(nIndex)];
+}
+
+template<class T> inline void TGapArray<T>::Set(size_t nIndex, T Item)
+{
+	ASSERT(nIndex < Size());
+
+	m_pData[Slot(nIndex)] = MoveItem(Item);
+}
+
+template<class T> inline size_t TGapArray<T>::Add(T Item)
+{
+	size_t nIndex = Size();
+
+	Insert(nIndex, MoveItem(Item));
+
+	return nIndex;
+}
+
+template<class T> inline size_t TGapArray<T>::AddRange(const T* pItems, size_t nCount)
+{
+	size_t nIndex = Size();
+
+	InsertItems(nIndex, pItems, nCount);
+
+	return nIndex;
+}
+
+template<class T> inline size_t TGapArray<T>::AddRange(const TArray<T>& oArray)
+{
+	return AddRange(oArray.begin(), oArray.Size());
+}
+
+template<class T> inline void TGapArray<T>::Insert(size_t nIndex, T Item)
+{
+	ASSERT(nIndex <= Size());
+
+	Grow(Size()+1);
+	MoveGap(nIndex);
+
+	new(m_pData + m_nGapStart) T(MoveItem(Item));
+	++m_nGapStart;
+}
+
+template<class T> inline void TGapArray<T>::InsertRange(size_t nIndex, const T* pFirst, const T* pLast)
+{
+	ASSERT(pFirst <= pLast);
+
+	InsertItems(nIndex, pFirst, pLast - pFirst);
+}
+
+template<class T> inline void TGapArray<T>::InsertRange(size_t nIndex, const TArray<T>& oArray)
+{
+	InsertItems(nIndex, oArray.begin(), oArray.Size());
+}
+
+template<class T> inline void TGapArray<T>::Remove(size_t nIndex)
+{
+	RemoveRange(nIndex, 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Remove the items by moving the gap in front of them and then widening it.
+
+template<class T> inline void TGapArray<T>::RemoveRange(size_t nIndex, size_t nCount)
+{
+	ASSERT((nIndex + nCount) <= Size());
+
+	MoveGap(nIndex);
+
+	for (size_t i = 0; i != nCount; ++i)
+		m_pData[m_nGapEnd+i].~T();
+
+	m_nGapEnd += nCount;
+}
+
+template<class T> inline void TGapArray<T>::RemoveAll()
+{
+	for (size_t i = 0; i != m_nGapStart; ++i)
+		m_pData[i].~T();
+
+	for (size_t i = m_nGapEnd; i != m_nCapacity; ++i)
+		m_pData[i].~T();
+
+	free(m_pData);
+
+	m_pData     = NULL;
+	m_nCapacity = 0;
+	m_nGapStart = 0;
+	m_nGapEnd   = 0;
+}
+
+template<class T> inline size_t TGapArray<T>::Find(T Item) const
+{
+	for (size_t i = 0; i != m_nGapStart; ++i)
+	{
+		if (m_pData[i] == Item)
+			return i;
+	}
+
+	for (size_t i = m_nGapEnd; i != m_nCapacity; ++i)
+	{
+		if (m_pData[i] == Item)
+			return i - (m_nGapEnd - m_nGapStart);
+	}
+
+	return Core::npos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Move the gap to the end so that the items are contiguous. The pointer is
+// valid until the next insert or remove.
+
+template<class T> inline const T* TGapArray<T>::Compact()
+{
+	MoveGap(Size());
+
+	return m_pData;
+}
+
+template<class T> inline size_t TGapArray<T>::size() const
+{
+	return Size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Get the first item. NB: The items are only contiguous after Compact().
+
+template<class T> inline typename TGapArray<T>::const_iterator TGapArray<T>::begin() const
+{
+	ASSERT(m_nGapEnd == m_nCapacity);
+
+	return m_pData;
+}
+
+template<class T> inline typename TGapArray<T>::const_iterator TGapArray<T>::end() const
+{
+	ASSERT(m_nGapEnd == m_nCapacity);
+
+	return m_pData + m_nGapStart;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Map an item index onto its buffer index.
+
+template<class T> inline size_t TGapArray<T>::Slot(size_t nIndex) const
+{
+	return (nIndex < m_nGapStart) ? nIndex : (nIndex + (m_nGapEnd - m_nGapStart));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Insert a block of items. The buffer is grown and the gap moved once, and the
+// items are then copied into the front of the gap.
+
+template<class T> inline void TGapArray<T>::InsertItems(size_t nIndex, const T* pItems, size_t nCount)
+{
+	ASSERT(nIndex <= Size());
+	ASSERT((pItems != NULL) || (nCount == 0));
+
+	// Nothing to insert?
+	if (nCount == 0)
+		return;
+
+	std::less<const T*> oLess;
+
+	// Inserting items from our own buffer?
+	if ( (!oLess(pItems, m_pData)) && (oLess(pItems, m_pData + m_nCapacity)) )
+	{
+		// Take a copy as moving the gap or growing the buffer will move them.
+		TArray<T> vCopy(pItems, pItems + nCount);
+
+		InsertItems(nIndex, vCopy.begin(), nCount);
+		return;
+	}
+
+	Grow(Size()+nCount);
+	MoveGap(nIndex);
+
+	CopyItems(m_pData + m_nGapStart, pItems, nCount, IsTrivial());
+	m_nGapStart += nCount;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Move the gap so that it starts at the item index, which moves the items
+// between the old and new positions to the other side of it.
+
+template<class T> inline void TGapArray<T>::MoveGap(size_t nIndex)
+{
+	size_t nGapSize = m_nGapEnd - m_nGapStart;
+
+	// No gap, i.e. the buffer is full, so there is nothing to move.
+	if (nGapSize == 0)
+	{
+		m_nGapStart = nIndex;
+		m_nGapEnd   = nIndex;
+		return;
+	}
+
+	if (nIndex < m_nGapStart)
+	{
+		size_t nCount = m_nGapStart - nIndex;
+
+		MoveItems(m_pData + nIndex + nGapSize, m_pData + nIndex, nCount, IsTrivial());
+	}
+	else if (nIndex > m_nGapStart)
+	{
+		size_t nCount = nIndex - m_nGapStart;
+
+		MoveItems(m_pData + m_nGapStart, m_pData + m_nGapEnd, nCount, IsTrivial());
+	}
+
+	m_nGapStart = nIndex;
+	m_nGapEnd   = nIndex + nGapSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Ensure there is space for at least the number of items requested, growing
+// the buffer by 50% so that repeated inserts are amortised O(1).
+
+template<class T> inline void TGapArray<T>::Grow(size_t nSize)
+{
+	if (nSize <= m_nCapacity)
+		return;
+
+	size_t nCapacity = m_nCapacity + (m_nCapacity / 2);
+
+	if (nCapacity < nSize)
+		nCapacity = nSize;
+
+	if (nCapacity < MIN_CAPACITY)
+		nCapacity = MIN_CAPACITY;
+
+	Reallocate(nCapacity);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Move the items to a new buffer, keeping the gap at the same item index.
+
+template<class T> inline void TGapArray<T>::Reallocate(size_t nCapacity)
+{
+	size_t nTail = m_nCapacity - m_nGapEnd;
+	T*     pData = static_cast<T*>(malloc(nCapacity * sizeof(T)));
+	ASSERT(pData);
+
+	MoveItems(pData, m_pData, m_nGapStart, IsTrivial());
+	MoveItems(pData + nCapacity - nTail, m_pData + m_nGapEnd, nTail, IsTrivial());
+
+	free(m_pData);
+
+	m_pData     = pData;
+	m_nGapEnd   = nCapacity - nTail;
+	m_nCapacity = nCapacity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Move items into the uninitialised slots, which may overlap the source.
+
+template<class T>
+inline void TGapArray<T>::MoveItems(T* pDst, T* pSrc, size_t nCount, TrueType)
+{
+	if (nCount != 0)
+		memmove(pDst, pSrc, nCount * sizeof(T));
+}
+
+template<class T>
+inline void TGapArray<T>::MoveItems(T* pDst, T* pSrc, size_t nCount, FalseType)
+{
+	// Moving down?
+	if (pDst < pSrc)
+	{
+		for (size_t i = 0; i != nCount; ++i)
+		{
+			new(pDst + i) T(MoveItem(pSrc[i]));
+			pSrc[i].~T();
+		}
+	}
+	else
+	{
+		for (size_t i = nCount; i != 0; --i)
+		{
+			new(pDst + i - 1) T(MoveItem(pSrc[i-1]));
+			pSrc[i-1].~T();
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Copy items into the uninitialised slots, which don't overlap the source.
+
+template<class T>
+inline void TGapArray<T>::CopyItems(T* pDst, const T* pSrc, size_t nCount, TrueType)
+{
+	memcpy(pDst, pSrc, nCount * sizeof(T));
+}
+
+template<class T>
+inline void TGapArray<T>::CopyItems(T* pDst, const T* pSrc, size_t nCount, FalseType)
+{
+	for (size_t i = 0; i != nCount; ++i)
+		new(pDst + i) T(pSrc[i]);
+}
+
+#endif // TGAPARRAY_HPP
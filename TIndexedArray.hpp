@@ -0,0 +1,415 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		TINDEXEDARRAY.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The TIndexedArray template class declaration.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef TINDEXEDARRAY_HPP
+#define TINDEXEDARRAY_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include "TArray.hpp"
+
+/******************************************************************************
+**
+** The default hash function for the index. Integral and pointer types are
+** hashed by mixing the bits of their value. Other types need a functor with
+** the same signature.
+**
+*******************************************************************************
+*/
+
+template<class T> struct TIndexHash
+{
+	size_t operator()(const T& Item) const
+	{
+		ULONGLONG nBits = TSimdSearchKey<T>::Bits(Item);
+
+		// MurmurHash3 finaliser.
+		nBits ^= nBits >> 33;
+		nBits *= 0xFF51AFD7ED558CCDULL;
+		nBits ^= nBits >> 33;
+		nBits *= 0xC4CEB9FE1A85EC53ULL;
+		nBits ^= nBits >> 33;
+
+		return static_cast<size_t>(nBits);
+	}
+};
+
+/******************************************************************************
+**
+** This is a TArray based class which keeps a hash index of its items so that
+** Find() is O(1) rather than a linear scan. The index maps each item onto its
+** position and is updated as items are added, set or removed at the end.
+**
+** Inserting or removing items in the middle moves the items after them, so
+** the index is just marked as stale and rebuilt once by the next Find(). A
+** batch of such edits therefore only costs a single rebuild.
+**
+*******************************************************************************
+*/
+
+template<class T, class H = TIndexHash<T> > class TIndexedArray : protected TArray<T>
+{
+public:
+	//
+	// Constructors/Destructor.
+	//
+	TIndexedArray();
+	explicit TIndexedArray(H oHash);
+	~TIndexedArray();
+
+	//
+	// Methods.
+	//
+	using TArray<T>::Size;
+	using TArray<T>::Capacity;
+	using TArray<T>::Reserve;
+	using TArray<T>::At;
+	using TArray<T>::operator[];
+
+	void Set(size_t nIndex, const T& Item);
+	size_t Add(const T& Item);
+	size_t AddRange(const T* pItems, size_t nCount);
+	size_t AddRange(const TArray<T>& oArray);
+	void Insert(size_t nIndex, const T& Item);
+
+	void Remove(size_t nIndex);
+	void RemoveRange(size_t nIndex, size_t nCount);
+	void RemoveAll();
+
+	size_t Find(const T& Item) const;
+	bool Contains(const T& Item) const;
+
+	void Reindex() const;
+
+	//
+	// std::vector compatibility types and methods.
+	//
+	typedef typename TArray<T>::const_iterator const_iterator;
+
+	using TArray<T>::size;
+
+	const_iterator begin() const;
+	const_iterator end() const;
+
+private:
+	// Template shorthands.
+	typedef TArray<T> Base;
+
+	// The smallest index size.
+	enum { MIN_SLOTS = 16 };
+
+	//
+	// Members.
+	//
+	H						m_oHash;	//!< The hash function.
+	mutable TArray<size_t>	m_vSlots;	//!< The item positions, by hash, or npos.
+	mutable bool			m_bStale;	//!< Does the index need rebuilding?
+
+	//
+	// Internal methods.
+	//
+	const T& ItemAt(size_t nIndex) const;
+	size_t Home(const T& Item) const;
+	void IndexItem(size_t nIndex) const;
+	void UnindexItem(size_t nIndex) const;
+
+	// Disallow copies for now.
+	TIndexedArray(const TIndexedArray<T, H>&);
+	void operator=(const TIndexedArray<T, H>&);
+};
+
+/******************************************************************************
+**
+** Implementation of TIndexedArray inline functions.
+**
+*******************************************************************************
+*/
+
+template<class T, class H> inline TIndexedArray<T, H>::TIndexedArray()
+	: m_oHash()
+	, m_vSlots()
+	, m_bStale(false)
+{
+}
+
+template<class T, class H> inline TIndexedArray<T, H>::TIndexedArray(H oHash)
+	: m_oHash(oHash)
+	, m_vSlots()
+	, m_bStale(false)
+{
+}
+
+template<class T, class H> inline TIndexedArray<T, H>::~TIndexedArray()
+{
+}
+
+template<class T, class H>
+inline void TIndexedArray<T, H>::Set(size_t nIndex, const T& Item)
+{
+	ASSERT(nIndex < Size());
+
+	if (!m_bStale)
+		UnindexItem(nIndex);
+
+	Base::Set(nIndex, Item);
+
+	if (!m_bStale)
+		IndexItem(nIndex);
+}
+
+template<class T, class H>
+inline size_t TIndexedArray<T, H>::Add(const T& Item)
+{
+	size_t nIndex = Base::Add(Item);
+
+	if (!m_bStale)
+		IndexItem(nIndex);
+
+	return nIndex;
+}
+
+template<class T, class H>
+inline size_t TIndexedArray<T, H>::AddRange(const T* pItems, size_t nCount)
+{
+	size_t nIndex = Base::AddRange(pItems, nCount);
+
+	// Index too small for the new items?
+	if ( (!m_bStale) && ((Size() * 2) > m_vSlots.Size()) )
+	{
+		Reindex();
+	}
+	else if (!m_bStale)
+	{
+		for (size_t i = nIndex; i != Size(); ++i)
+			IndexItem(i);
+	}
+
+	return nIndex;
+}
+
+template<class T, class H>
+inline size_t TIndexedArray<T, H>::AddRange(const TArray<T>& oArray)
+{
+	return AddRange(oArray.begin(), oArray.Size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Insert an item. This moves the items after it and so makes the index stale.
+
+template<class T, class H>
+inline void TIndexedArray<T, H>::Insert(size_t nIndex, const T& Item)
+{
+	ASSERT(nIndex <= Size());
+
+	if (nIndex == Size())
+	{
+		Add(Item);
+		return;
+	}
+
+	Base::Insert(nIndex, Item);
+
+	m_bStale = true;
+}
+
+template<class T, class H>
+inline void TIndexedArray<T, H>::Remove(size_t nIndex)
+{
+	RemoveRange(nIndex, 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Remove a range of items. Removing from the end keeps the index up to date,
+// otherwise the items after them move and so the index becomes stale.
+
+template<class T, class H>
+inline void TIndexedArray<T, H>::RemoveRange(size_t nIndex, size_t nCount)
+{
+	ASSERT(nIndex <= Size());
+	ASSERT(nCount <= (Size() - nIndex));
+
+	if ( (!m_bStale) && ((nIndex + nCount) == Size()) )
+	{
+		for (size_t i = nIndex; i != Size(); ++i)
+			UnindexItem(i);
+	}
+	else if (nCount != 0)
+	{
+		m_bStale = true;
+	}
+
+	Base::RemoveRange(nIndex, nCount);
+}
+
+template<class T, class H>
+inline void TIndexedArray<T, H>::RemoveAll()
+{
+	Base::RemoveAll();
+
+	m_vSlots.RemoveAll();
+	m_bStale = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Find the index of the first item equal to the value or Core::npos. Equal
+// items share a probe sequence, which is searched for the lowest position.
+
+template<class T, class H>
+inline size_t TIndexedArray<T, H>::Find(const T& Item) const
+{
+	if (m_bStale)
+		Reindex();
+
+	if (m_vSlots.Size() == 0)
+		return Core::npos;
+
+	const size_t* pSlots = m_vSlots.begin();
+	size_t        nMask  = m_vSlots.Size() - 1;
+	size_t        nFound = Core::npos;
+
+	for (size_t i = Home(Item); pSlots[i] != Core::npos; i = (i + 1) & nMask)
+	{
+		size_t nIndex = pSlots[i];
+
+		if ( (nIndex < nFound) && (ItemAt(nIndex) == Item) )
+			nFound = nIndex;
+	}
+
+	return nFound;
+}
+
+template<class T, class H>
+inline bool TIndexedArray<T, H>::Contains(const T& Item) const
+{
+	return (Find(Item) != Core::npos);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Rebuild the index, sized so that it is no more than half full.
+
+template<class T, class H>
+inline void TIndexedArray<T, H>::Reindex() const
+{
+	size_t nSlots = MIN_SLOTS;
+
+	while (nSlots < (Size() * 2))
+		nSlots *= 2;
+
+	m_vSlots.RemoveRange(0, m_vSlots.Size());
+	m_vSlots.Reserve(nSlots);
+
+	for (size_t i = 0; i != nSlots; ++i)
+		m_vSlots.Add(Core::npos);
+
+	size_t* pSlots = m_vSlots.begin();
+	size_t  nMask  = nSlots - 1;
+
+	for (size_t n = 0; n != Size(); ++n)
+	{
+		size_t i = Home(ItemAt(n));
+
+		while (pSlots[i] != Core::npos)
+			i = (i + 1) & nMask;
+
+		pSlots[i] = n;
+	}
+
+	m_bStale = false;
+}
+
+template<class T, class H>
+inline typename TIndexedArray<T, H>::const_iterator TIndexedArray<T, H>::begin() const
+{
+	return Base::begin();
+}
+
+template<class T, class H>
+inline typename TIndexedArray<T, H>::const_iterator TIndexedArray<T, H>::end() const
+{
+	return Base::end();
+}
+
+template<class T, class H>
+inline const T& TIndexedArray<T, H>::ItemAt(size_t nIndex) const
+{
+	return *(Base::begin() + nIndex);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Get the slot at which the probe sequence for an item starts.
+
+template<class T, class H>
+inline size_t TIndexedArray<T, H>::Home(const T& Item) const
+{
+	return m_oHash(Item) & (m_vSlots.Size() - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Add an item's position to the index. If the index would be over half full
+// it is rebuilt instead, which also indexes the item.
+
+template<class T, class H>
+inline void TIndexedArray<T, H>::IndexItem(size_t nIndex) const
+{
+	if ((Size() * 2) > m_vSlots.Size())
+	{
+		Reindex();
+		return;
+	}
+
+	size_t* pSlots = m_vSlots.begin();
+	size_t  nMask  = m_vSlots.Size() - 1;
+	size_t  i      = Home(ItemAt(nIndex));
+
+	while (pSlots[i] != Core::npos)
+		i = (i + 1) & nMask;
+
+	pSlots[i] = nIndex;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Remove an item's position from the index. The following slots in the probe
+// sequence are shifted back into the gap so that no tombstones are needed.
+
+template<class T, class H>
+inline void TIndexedArray<T, H>::UnindexItem(size_t nIndex) const
+{
+	size_t* pSlots = m_vSlots.begin();
+	size_t  nMask  = m_vSlots.Size() - 1;
+	size_t  i      = Home(ItemAt(nIndex));
+
+	while (pSlots[i] != nIndex)
+	{
+		ASSERT(pSlots[i] != Core::npos);
+
+		i = (i + 1) & nMask;
+	}
+
+	for (size_t j = (i + 1) & nMask; pSlots[j] != Core::npos; j = (j + 1) & nMask)
+	{
+		size_t k = Home(ItemAt(pSlots[j]));
+
+		// Would the gap be skipped when probing from the item's home slot?
+		bool bMove = (i <= j) ? ((k <= i) || (k > j)) : ((k <= i) && (k > j));
+
+		if (bMove)
+		{
+			pSlots[i] = pSlots[j];
+			i = j;
+		}
+	}
+
+	pSlots[i] = Core::npos;
+}
+
+#endif // TINDEXEDARRAY_HPP
@@ -0,0 +1,251 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		TPACKEDINTARRAY.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The TPackedIntArray template class declaration.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef TPACKEDINTARRAY_HPP
+#define TPACKEDINTARRAY_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include "TArray.hpp"
+#include "BitPacking.hpp"
+
+/******************************************************************************
+**
+** This is a template class used for append-only arrays of integers of up to
+** 32 bits which are compressed to save memory. The items are stored in blocks
+** of CBitPacking::BLOCK_SIZE, each as an offset from the block minimum packed
+** into just enough bits for the largest one, i.e. "frame of reference" coding.
+** The items are still randomly accessible.
+**
+** NB: The items added since the last full block are kept unpacked.
+**
+*******************************************************************************
+*/
+
+template<class T> class TPackedIntArray
+{
+public:
+	//
+	// Constructors/Destructor.
+	//
+	TPackedIntArray();
+	~TPackedIntArray();
+
+	//
+	// Methods.
+	//
+	size_t Size() const;
+
+	T At(size_t nIndex) const;
+	T operator[](size_t nIndex) const;
+
+	size_t Add(T nItem);
+	size_t AddRange(const T* pItems, size_t nCount);
+	size_t AddRange(const TArray<T>& oArray);
+	void RemoveAll();
+
+	void Decode(TArray<T>& oArray) const;
+
+	size_t PackedSize() const;
+
+private:
+	// The header for a packed block.
+	struct Block
+	{
+		uint	m_nMin;		//!< The block minimum.
+		uint	m_nWidth;	//!< The number of bits per item.
+		size_t	m_nOffset;	//!< The index of the first word.
+	};
+
+	// Template shorthands.
+	typedef TArray<Block> CBlocks;
+	typedef TArray<uint>  CWords;
+	typedef TArray<T>     CItems;
+
+	//
+	// Members.
+	//
+	CBlocks	m_vBlocks;		//!< The packed block headers.
+	CWords	m_vWords;		//!< The packed blocks.
+	CItems	m_vTail;		//!< The items not yet packed.
+
+	//
+	// Internal methods.
+	//
+	void PackTail();
+
+	// Disallow copies for now.
+	TPackedIntArray(const TPackedIntArray<T>&);
+	void operator=(const TPackedIntArray<T>&);
+};
+
+/******************************************************************************
+**
+** Implementation of TPackedIntArray inline functions.
+**
+*******************************************************************************
+*/
+
+template<class T> inline TPackedIntArray<T>::TPackedIntArray()
+	: m_vBlocks()
+	, m_vWords()
+	, m_vTail()
+{
+	(void)sizeof(TStaticAssert<sizeof(T) <= sizeof(uint)>);
+}
+
+template<class T> inline TPackedIntArray<T>::~TPackedIntArray()
+{
+}
+
+template<class T> inline size_t TPackedIntArray<T>::Size() const
+{
+	return (m_vBlocks.Size() * CBitPacking::BLOCK_SIZE) + m_vTail.Size();
+}
+
+template<class T> inline T TPackedIntArray<T>::At(size_t nIndex) const
+{
+	ASSERT(nIndex < Size());
+
+	size_t nBlock = nIndex / CBitPacking::BLOCK_SIZE;
+
+	if (nBlock == m_vBlocks.Size())
+		return m_vTail[nIndex % CBitPacking::BLOCK_SIZE];
+
+	const Block& oBlock = *(m_vBlocks.begin() + nBlock);
+	const uint*  pWords = m_vWords.begin() + oBlock.m_nOffset;
+
+	uint nDelta = CBitPacking::Extract(pWords, oBlock.m_nWidth, nIndex % CBitPacking::BLOCK_SIZE);
+
+	return static_cast<T>(oBlock.m_nMin + nDelta);
+}
+
+template<class T> inline T TPackedIntArray<T>::operator[](size_t nIndex) const
+{
+	return At(nIndex);
+}
+
+template<class T> inline size_t TPackedIntArray<T>::Add(T nItem)
+{
+	size_t nIndex = Size();
+
+	m_vTail.Add(nItem);
+
+	if (m_vTail.Size() == CBitPacking::BLOCK_SIZE)
+		PackTail();
+
+	return nIndex;
+}
+
+template<class T> inline size_t TPackedIntArray<T>::AddRange(const T* pItems, size_t nCount)
+{
+	size_t nIndex = Size();
+
+	for (size_t i = 0; i != nCount; ++i)
+		Add(pItems[i]);
+
+	return nIndex;
+}
+
+template<class T> inline size_t TPackedIntArray<T>::AddRange(const TArray<T>& oArray)
+{
+	return AddRange(oArray.begin(), oArray.Size());
+}
+
+template<class T> inline void TPackedIntArray<T>::RemoveAll()
+{
+	m_vBlocks.RemoveAll();
+	m_vWords.RemoveAll();
+	m_vTail.RemoveAll();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Append all the items to an array, unpacking a whole block at a time.
+
+template<class T> inline void TPackedIntArray<T>::Decode(TArray<T>& oArray) const
+{
+	uint aValues[CBitPacking::BLOCK_SIZE];
+	T    aItems[CBitPacking::BLOCK_SIZE];
+
+	oArray.Reserve(oArray.Size() + Size());
+
+	for (size_t b = 0; b != m_vBlocks.Size(); ++b)
+	{
+		const Block& oBlock = *(m_vBlocks.begin() + b);
+
+		CBitPacking::Unpack(m_vWords.begin() + oBlock.m_nOffset, oBlock.m_nWidth, oBlock.m_nMin, aValues);
+
+		for (size_t i = 0; i != CBitPacking::BLOCK_SIZE; ++i)
+			aItems[i] = static_cast<T>(aValues[i]);
+
+		oArray.AddRange(aItems, CBitPacking::BLOCK_SIZE);
+	}
+
+	oArray.AddRange(m_vTail);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Get the approximate number of bytes used to store the items.
+
+template<class T> inline size_t TPackedIntArray<T>::PackedSize() const
+{
+	return (m_vBlocks.Size() * sizeof(Block)) + (m_vWords.Size() * sizeof(uint))
+		 + (m_vTail.Size() * sizeof(T));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Pack the full tail into a new block. The deltas are calculated with unsigned
+// arithmetic so that they are correct for signed types too.
+
+template<class T> inline void TPackedIntArray<T>::PackTail()
+{
+	ASSERT(m_vTail.Size() == CBitPacking::BLOCK_SIZE);
+
+	const T* pItems = m_vTail.begin();
+	T        nMin   = pItems[0];
+	T        nMax   = pItems[0];
+
+	for (size_t i = 1; i != CBitPacking::BLOCK_SIZE; ++i)
+	{
+		if (pItems[i] < nMin)
+			nMin = pItems[i];
+		else if (pItems[i] > nMax)
+			nMax = pItems[i];
+	}
+
+	uint aDeltas[CBitPacking::BLOCK_SIZE];
+
+	for (size_t i = 0; i != CBitPacking::BLOCK_SIZE; ++i)
+		aDeltas[i] = static_cast<uint>(pItems[i]) - static_cast<uint>(nMin);
+
+	Block oBlock;
+
+	oBlock.m_nMin    = static_cast<uint>(nMin);
+	oBlock.m_nWidth  = CBitPacking::Width(static_cast<uint>(nMax) - static_cast<uint>(nMin));
+	oBlock.m_nOffset = m_vWords.Size();
+
+	size_t nWords = CBitPacking::NumWords(oBlock.m_nWidth);
+
+	for (size_t i = 0; i != nWords; ++i)
+		m_vWords.Add(0);
+
+	if (nWords != 0)
+		CBitPacking::Pack(aDeltas, oBlock.m_nWidth, m_vWords.begin() + oBlock.m_nOffset);
+
+	m_vBlocks.Add(oBlock);
+
+	// Keep the buffer for the next block.
+	m_vTail.RemoveRange(0, m_vTail.Size());
+}
+
+#endif // TPACKEDINTARRAY_HPP
@@ -0,0 +1,311 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		TRINGARRAY.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The TRingArray template class declaration.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef TRINGARRAY_HPP
+#define TRINGARRAY_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include "TypeTraits.hpp"
+#include <stdlib.h>
+#include <new>
+
+/******************************************************************************
+**
+** This is a template class used for double-ended arrays, e.g. FIFO queues.
+** The items are stored in a circular buffer so that items can be added and
+** removed at either end in O(1). The buffer size is always a power of 2 and
+** doubles when full.
+**
+*******************************************************************************
+*/
+
+template<class T> class TRingArray
+{
+public:
+	//
+	// Constructors/Destructor.
+	//
+	TRingArray();
+	~TRingArray();
+
+	//
+	// Methods.
+	//
+	size_t Size() const;
+	bool Empty() const;
+
+	size_t Capacity() const;
+	void Reserve(size_t nSize);
+
+	T At(size_t nIndex) const;
+	T operator[](size_t nIndex) const;
+	void Set(size_t nIndex, T Item);
+
+	T Front() const;
+	T Back() const;
+
+	void PushFront(T Item);
+	void PushBack(T Item);
+	T PopFront();
+	T PopBack();
+
+	void RemoveAll();
+
+	//
+	// The items as two contiguous spans, the second of which is empty unless
+	// the items wrap around the end of the buffer.
+	//
+	const T* FirstSpan(size_t& nCount) const;
+	const T* SecondSpan(size_t& nCount) const;
+
+	T* FirstSpan(size_t& nCount);
+	T* SecondSpan(size_t& nCount);
+
+private:
+	// The smallest buffer size allocated.
+	enum { MIN_CAPACITY = 8 };
+
+	//
+	// Members.
+	//
+	T*		m_pData;		//!< The buffer.
+	size_t	m_nCapacity;	//!< The buffer size, a power of 2.
+	size_t	m_nHead;		//!< The buffer index of the first item.
+	size_t	m_nSize;		//!< The number of items.
+
+	//
+	// Internal methods.
+	//
+	size_t Slot(size_t nIndex) const;
+	void Grow(size_t nSize);
+	void Reallocate(size_t nCapacity);
+
+	// Disallow copies for now.
+	TRingArray(const TRingArray<T>&);
+	void operator=(const TRingArray<T>&);
+};
+
+/******************************************************************************
+**
+** Implementation of TRingArray inline functions.
+**
+*******************************************************************************
+*/
+
+template<class T> inline TRingArray<T>::TRingArray()
+	: m_pData(NULL)
+	, m_nCapacity(0)
+	, m_nHead(0)
+	, m_nSize(0)
+{
+}
+
+template<class T> inline TRingArray<T>::~TRingArray()
+{
+	RemoveAll();
+}
+
+template<class T> inline size_t TRingArray<T>::Size() const
+{
+	return m_nSize;
+}
+
+template<class T> inline bool TRingArray<T>::Empty() const
+{
+	return (m_nSize == 0);
+}
+
+template<class T> inline size_t TRingArray<T>::Capacity() const
+{
+	return m_nCapacity;
+}
+
+template<class T> inline void TRingArray<T>::Reserve(size_t nSize)
+{
+	Grow(nSize);
+}
+
+template<class T> inline T TRingArray<T>::At(size_t nIndex) const
+{
+	ASSERT(nIndex < m_nSize);
+
+	return m_pData[Slot(nIndex)];
+}
+
+template<class T> inline T TRingArray<T>::operator[](size_t nIndex) const
+{
+	ASSERT(nIndex < m_nSize);
+
+	return m_pData[Slot(nIndex)];
+}
+
+template<class T> inline void TRingArray<T>::Set(size_t nIndex, T Item)
+{
+	ASSERT(nIndex < m_nSize);
+
+	m_pData[Slot(nIndex)] = MoveItem(Item);
+}
+
+template<class T> inline T TRingArray<T>::Front() const
+{
+	ASSERT(m_nSize > 0);
+
+	return m_pData[m_nHead];
+}
+
+template<class T> inline T TRingArray<T>::Back() const
+{
+	ASSERT(m_nSize > 0);
+
+	return m_pData[Slot(m_nSize-1)];
+}
+
+template<class T> inline void TRingArray<T>::PushFront(T Item)
+{
+	Grow(m_nSize+1);
+
+	m_nHead = (m_nHead - 1) & (m_nCapacity - 1);
+
+	new(m_pData + m_nHead) T(MoveItem(Item));
+	++m_nSize;
+}
+
+template<class T> inline void TRingArray<T>::PushBack(T Item)
+{
+	Grow(m_nSize+1);
+
+	new(m_pData + Slot(m_nSize)) T(MoveItem(Item));
+	++m_nSize;
+}
+
+template<class T> inline T TRingArray<T>::PopFront()
+{
+	ASSERT(m_nSize > 0);
+
+	T* pItem = m_pData + m_nHead;
+	T  Item(MoveItem(*pItem));
+
+	pItem->~T();
+
+	m_nHead = (m_nHead + 1) & (m_nCapacity - 1);
+	--m_nSize;
+
+	return Item;
+}
+
+template<class T> inline T TRingArray<T>::PopBack()
+{
+	ASSERT(m_nSize > 0);
+
+	T* pItem = m_pData + Slot(m_nSize-1);
+	T  Item(MoveItem(*pItem));
+
+	pItem->~T();
+
+	--m_nSize;
+
+	return Item;
+}
+
+template<class T> inline void TRingArray<T>::RemoveAll()
+{
+	for (size_t i = 0; i != m_nSize; ++i)
+		m_pData[Slot(i)].~T();
+
+	free(m_pData);
+
+	m_pData     = NULL;
+	m_nCapacity = 0;
+	m_nHead     = 0;
+	m_nSize     = 0;
+}
+
+template<class T> inline const T* TRingArray<T>::FirstSpan(size_t& nCount) const
+{
+	nCount = (m_nSize < (m_nCapacity - m_nHead)) ? m_nSize : (m_nCapacity - m_nHead);
+
+	return m_pData + m_nHead;
+}
+
+template<class T> inline const T* TRingArray<T>::SecondSpan(size_t& nCount) const
+{
+	size_t nFirst;
+
+	FirstSpan(nFirst);
+
+	nCount = m_nSize - nFirst;
+
+	return m_pData;
+}
+
+template<class T> inline T* TRingArray<T>::FirstSpan(size_t& nCount)
+{
+	return const_cast<T*>(static_cast<const TRingArray<T>*>(this)->FirstSpan(nCount));
+}
+
+template<class T> inline T* TRingArray<T>::SecondSpan(size_t& nCount)
+{
+	return const_cast<T*>(static_cast<const TRingArray<T>*>(this)->SecondSpan(nCount));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Map an item index onto its buffer index.
+
+template<class T> inline size_t TRingArray<T>::Slot(size_t nIndex) const
+{
+	return (m_nHead + nIndex) & (m_nCapacity - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Ensure there is space for at least the number of items requested, doubling
+// the buffer size until there is.
+
+template<class T> inline void TRingArray<T>::Grow(size_t nSize)
+{
+	if (nSize <= m_nCapacity)
+		return;
+
+	size_t nCapacity = (m_nCapacity != 0) ? (m_nCapacity * 2) : static_cast<size_t>(MIN_CAPACITY);
+
+	while (nCapacity < nSize)
+		nCapacity *= 2;
+
+	Reallocate(nCapacity);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Move the items to a new buffer, unwrapping them so that they start at the
+// beginning of it.
+
+template<class T> inline void TRingArray<T>::Reallocate(size_t nCapacity)
+{
+	T* pData = static_cast<T*>(malloc(nCapacity * sizeof(T)));
+	ASSERT(pData);
+
+	for (size_t i = 0; i != m_nSize; ++i)
+	{
+		T* pItem = m_pData + Slot(i);
+
+		new(pData + i) T(MoveItem(*pItem));
+		pItem->~T();
+	}
+
+	free(m_pData);
+
+	m_pData     = pData;
+	m_nCapacity = nCapacity;
+	m_nHead     = 0;
+}
+
+#endif // TRINGARRAY_HPP
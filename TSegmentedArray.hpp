@@ -0,0 +1,237 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		TSEGMENTEDARRAY.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The TSegmentedArray template class declaration.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef TSEGMENTEDARRAY_HPP
+#define TSEGMENTEDARRAY_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include "TArray.hpp"
+#include <stdlib.h>
+#include <new>
+
+/******************************************************************************
+**
+** This is a template class used for arrays which store their items in a list
+** of fixed size blocks. Growing the array only adds a block, so the existing
+** items are never moved, pointers to them remain valid and appending is O(1)
+** without the occasional cost of copying the entire buffer.
+**
+** NB: The block size should be a power of 2 so that indexing uses a shift.
+**
+*******************************************************************************
+*/
+
+template<class T, size_t N = 256> class TSegmentedArray
+{
+public:
+	//
+	// Constructors/Destructor.
+	//
+	TSegmentedArray();
+	~TSegmentedArray();
+
+	//
+	// Methods.
+	//
+	size_t Size() const;
+
+	size_t Capacity() const;
+	void Reserve(size_t nSize);
+
+	T At(size_t nIndex) const;
+	T operator[](size_t nIndex) const;
+
+	const T* Ptr(size_t nIndex) const;
+	T* Ptr(size_t nIndex);
+
+	void Set(size_t nIndex, T Item);
+	size_t Add(T Item);
+	void RemoveLast();
+	void RemoveAll();
+
+	size_t Find(T Item) const;
+
+private:
+	// Template shorthands.
+	typedef TArray<T*> CBlocks;
+	typedef TBoolType<TSimdSearchKey<T>::IS_SEARCHABLE> IsSearchable;
+
+	//
+	// Members.
+	//
+	CBlocks	m_vBlocks;		//!< The blocks of items.
+	size_t	m_nSize;		//!< The number of items.
+
+	//
+	// Internal methods.
+	//
+	void AddBlock();
+
+	static size_t FindInBlock(const T* pBlock, size_t nCount, T Item, TrueType);
+	static size_t FindInBlock(const T* pBlock, size_t nCount, T Item, FalseType);
+
+	// Disallow copies for now.
+	TSegmentedArray(const TSegmentedArray<T, N>&);
+	void operator=(const TSegmentedArray<T, N>&);
+};
+
+/******************************************************************************
+**
+** Implementation of TSegmentedArray inline functions.
+**
+*******************************************************************************
+*/
+
+template<class T, size_t N> inline TSegmentedArray<T, N>::TSegmentedArray()
+	: m_vBlocks()
+	, m_nSize(0)
+{
+}
+
+template<class T, size_t N> inline TSegmentedArray<T, N>::~TSegmentedArray()
+{
+	RemoveAll();
+}
+
+template<class T, size_t N> inline size_t TSegmentedArray<T, N>::Size() const
+{
+	return m_nSize;
+}
+
+template<class T, size_t N> inline size_t TSegmentedArray<T, N>::Capacity() const
+{
+	return m_vBlocks.Size() * N;
+}
+
+template<class T, size_t N> inline void TSegmentedArray<T, N>::Reserve(size_t nSize)
+{
+	while (Capacity() < nSize)
+		AddBlock();
+}
+
+template<class T, size_t N> inline T TSegmentedArray<T, N>::At(size_t nIndex) const
+{
+	return *Ptr(nIndex);
+}
+
+template<class T, size_t N> inline T TSegmentedArray<T, N>::operator[](size_t nIndex) const
+{
+	return *Ptr(nIndex);
+}
+
+template<class T, size_t N>
+inline const T* TSegmentedArray<T, N>::Ptr(size_t nIndex) const
+{
+	ASSERT(nIndex < m_nSize);
+
+	return m_vBlocks[nIndex / N] + (nIndex % N);
+}
+
+template<class T, size_t N>
+inline T* TSegmentedArray<T, N>::Ptr(size_t nIndex)
+{
+	ASSERT(nIndex < m_nSize);
+
+	return m_vBlocks[nIndex / N] + (nIndex % N);
+}
+
+template<class T, size_t N> inline void TSegmentedArray<T, N>::Set(size_t nIndex, T Item)
+{
+	*Ptr(nIndex) = MoveItem(Item);
+}
+
+template<class T, size_t N> inline size_t TSegmentedArray<T, N>::Add(T Item)
+{
+	if (m_nSize == Capacity())
+		AddBlock();
+
+	new(m_vBlocks[m_nSize / N] + (m_nSize % N)) T(MoveItem(Item));
+
+	return m_nSize++;
+}
+
+template<class T, size_t N> inline void TSegmentedArray<T, N>::RemoveLast()
+{
+	ASSERT(m_nSize > 0);
+
+	Ptr(m_nSize-1)->~T();
+	--m_nSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Destroy the items and free all the blocks.
+
+template<class T, size_t N> inline void TSegmentedArray<T, N>::RemoveAll()
+{
+	for (size_t i = 0; i != m_nSize; ++i)
+		Ptr(i)->~T();
+
+	for (size_t i = 0; i != m_vBlocks.Size(); ++i)
+		free(m_vBlocks[i]);
+
+	m_vBlocks.RemoveAll();
+	m_nSize = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Find the first item with the given value. Each block is searched in turn,
+// with SIMD when the item type allows.
+
+template<class T, size_t N> inline size_t TSegmentedArray<T, N>::Find(T Item) const
+{
+	for (size_t nFirst = 0, b = 0; nFirst < m_nSize; nFirst += N, ++b)
+	{
+		size_t nCount = ((m_nSize - nFirst) < N) ? (m_nSize - nFirst) : N;
+		size_t nIndex = FindInBlock(m_vBlocks[b], nCount, Item, IsSearchable());
+
+		if (nIndex != Core::npos)
+			return nFirst + nIndex;
+	}
+
+	return Core::npos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Append an empty block. Only the directory of blocks is reallocated.
+
+template<class T, size_t N> inline void TSegmentedArray<T, N>::AddBlock()
+{
+	T* pBlock = static_cast<T*>(malloc(N * sizeof(T)));
+	ASSERT(pBlock);
+
+	m_vBlocks.Add(pBlock);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Find the first item in a block using SIMD or a plain loop.
+
+template<class T, size_t N>
+inline size_t TSegmentedArray<T, N>::FindInBlock(const T* pBlock, size_t nCount, T Item, TrueType)
+{
+	return CSimdSearch::Find(pBlock, nCount, sizeof(T), TSimdSearchKey<T>::Bits(Item));
+}
+
+template<class T, size_t N>
+inline size_t TSegmentedArray<T, N>::FindInBlock(const T* pBlock, size_t nCount, T Item, FalseType)
+{
+	for (size_t i = 0; i != nCount; ++i)
+	{
+		if (pBlock[i] == Item)
+			return i;
+	}
+
+	return Core::npos;
+}
+
+#endif // TSEGMENTEDARRAY_HPP
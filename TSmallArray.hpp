@@ -0,0 +1,78 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		TSMALLARRAY.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The TSmallArray template class declaration.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef TSMALLARRAY_HPP
+#define TSMALLARRAY_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include "TArray.hpp"
+
+/******************************************************************************
+**
+** This is a TArray based class which stores the first N items inline and only
+** allocates a buffer on the heap when it grows beyond that.
+**
+*******************************************************************************
+*/
+
+template<class T, size_t N> class TSmallArray : public TArray<T>
+{
+public:
+	//
+	// Constructors/Destructor.
+	//
+	TSmallArray();
+	~TSmallArray();
+
+private:
+	//
+	// The inline buffer, aligned for any of the built-in types.
+	//
+	union InlineBuffer
+	{
+		byte		m_aBytes[N * sizeof(T)];
+		double		m_dAlign;
+		LONGLONG	m_nAlign;
+		void*		m_pAlign;
+	};
+
+	//
+	// Members.
+	//
+	InlineBuffer	m_oInline;
+
+	// Disallow copies for now.
+	TSmallArray(const TSmallArray<T, N>&);
+	void operator=(const TSmallArray<T, N>&);
+};
+
+/******************************************************************************
+**
+** Implementation of TSmallArray inline functions.
+**
+*******************************************************************************
+*/
+
+template<class T, size_t N> inline TSmallArray<T, N>::TSmallArray()
+	: TArray<T>(m_oInline.m_aBytes, N)
+{
+}
+
+template<class T, size_t N> inline TSmallArray<T, N>::~TSmallArray()
+{
+	// Release any heap buffer before the inline one goes.
+	this->RemoveAll();
+}
+
+#endif // TSMALLARRAY_HPP
@@ -0,0 +1,421 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		TSORTEDARRAY.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The TSortedArray template class declaration.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef TSORTEDARRAY_HPP
+#define TSORTEDARRAY_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include "TArray.hpp"
+#include <functional>
+
+/******************************************************************************
+**
+** This is a TArray based class which keeps its items sorted so that they can
+** be found with a binary search. Equal items are kept in the order they were
+** added.
+**
+** Read-mostly arrays can also keep a copy of the items in the Eytzinger (BFS)
+** layout, which makes the search branch free and cache friendly. The copy is
+** rebuilt after every change, so batch changes should use Merge().
+**
+*******************************************************************************
+*/
+
+template<class T, class C = std::less<T> > class TSortedArray : protected TArray<T>
+{
+public:
+	// The layout used for searching.
+	enum SearchLayout
+	{
+		SEARCH_BINARY,		// Binary search of the sorted items.
+		SEARCH_EYTZINGER	// Branch free search of an Eytzinger copy.
+	};
+
+	//
+	// Constructors/Destructor.
+	//
+	TSortedArray();
+	explicit TSortedArray(C oLess);
+	TSortedArray(const TSortedArray<T, C>& oArray);
+	~TSortedArray();
+
+	//
+	// Methods.
+	//
+	using TArray<T>::Size;
+	using TArray<T>::Capacity;
+	using TArray<T>::Reserve;
+	using TArray<T>::ShrinkToFit;
+	using TArray<T>::At;
+	using TArray<T>::operator[];
+
+	void SetSearchLayout(SearchLayout eLayout);
+
+	size_t Insert(const T& Item);
+	void Merge(const T* pItems, size_t nCount);
+	void Merge(const TArray<T>& oArray);
+
+	void Remove(size_t nIndex);
+	void RemoveRange(size_t nIndex, size_t nCount);
+	void RemoveAll();
+
+	size_t LowerBound(const T& Item) const;
+	size_t UpperBound(const T& Item) const;
+	size_t Find(const T& Item) const;
+	bool Contains(const T& Item) const;
+
+	//
+	// std::vector compatibility types and methods.
+	//
+	typedef typename TArray<T>::const_iterator const_iterator;
+
+	using TArray<T>::size;
+
+	const_iterator begin() const;
+	const_iterator end() const;
+
+private:
+	// Template shorthands.
+	typedef TArray<T> Base;
+
+	//
+	// Members.
+	//
+	C				m_oLess;		//!< The comparison predicate.
+	SearchLayout	m_eLayout;		//!< The layout used for searching.
+	TArray<T>		m_vTree;		//!< The Eytzinger copy, from index 1.
+	TArray<size_t>	m_vIndices;		//!< The sorted index of each tree item.
+
+	//
+	// Internal methods.
+	//
+	template<class P>
+	size_t TreeSearch(P oBefore) const;
+	void BuildTree();
+	void BuildTree(size_t nNode, size_t& nIndex);
+	bool IsSorted(const T* pItems, size_t nCount) const;
+
+	// Disallow assignment for now.
+	void operator=(const TSortedArray<T, C>&);
+};
+
+/******************************************************************************
+**
+** The predicates used to find where the lower and upper bounds lie.
+**
+*******************************************************************************
+*/
+
+template<class T, class C> struct TLowerBoundPred
+{
+	TLowerBoundPred(const C& oLess, const T& Item)
+		: m_oLess(oLess), m_Item(Item)
+	{ }
+
+	bool operator()(const T& Item) const
+	{
+		return m_oLess(Item, m_Item);
+	}
+
+	const C&	m_oLess;
+	const T&	m_Item;
+};
+
+template<class T, class C> struct TUpperBoundPred
+{
+	TUpperBoundPred(const C& oLess, const T& Item)
+		: m_oLess(oLess), m_Item(Item)
+	{ }
+
+	bool operator()(const T& Item) const
+	{
+		return !m_oLess(m_Item, Item);
+	}
+
+	const C&	m_oLess;
+	const T&	m_Item;
+};
+
+/******************************************************************************
+**
+** Implementation of TSortedArray inline functions.
+**
+*******************************************************************************
+*/
+
+template<class T, class C> inline TSortedArray<T, C>::TSortedArray()
+	: m_oLess()
+	, m_eLayout(SEARCH_BINARY)
+	, m_vTree()
+	, m_vIndices()
+{
+}
+
+template<class T, class C> inline TSortedArray<T, C>::TSortedArray(C oLess)
+	: m_oLess(oLess)
+	, m_eLayout(SEARCH_BINARY)
+	, m_vTree()
+	, m_vIndices()
+{
+}
+
+template<class T, class C>
+inline TSortedArray<T, C>::TSortedArray(const TSortedArray<T, C>& oArray)
+	: Base(oArray)
+	, m_oLess(oArray.m_oLess)
+	, m_eLayout(oArray.m_eLayout)
+	, m_vTree(oArray.m_vTree)
+	, m_vIndices(oArray.m_vIndices)
+{
+}
+
+template<class T, class C> inline TSortedArray<T, C>::~TSortedArray()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Set the layout used for searching, building the Eytzinger copy if required.
+
+template<class T, class C>
+inline void TSortedArray<T, C>::SetSearchLayout(SearchLayout eLayout)
+{
+	m_eLayout = eLayout;
+
+	BuildTree();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Insert the item after any equal items. Returns the index of the new item.
+
+template<class T, class C>
+inline size_t TSortedArray<T, C>::Insert(const T& Item)
+{
+	size_t nIndex = std::upper_bound(Base::begin(), Base::end(), Item, m_oLess) - Base::begin();
+
+	Base::Insert(nIndex, Item);
+
+	BuildTree();
+
+	return nIndex;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Merge a sorted range of items in a single pass, from the back, so that each
+// item is moved at most once. Items are added after any equal items.
+
+template<class T, class C>
+inline void TSortedArray<T, C>::Merge(const T* pItems, size_t nCount)
+{
+	ASSERT(IsSorted(pItems, nCount));
+
+	if (nCount == 0)
+		return;
+
+	// Merging our own items?
+	if ( (pItems >= Base::begin()) && (pItems < Base::end()) )
+	{
+		TArray<T> oCopy;
+
+		oCopy.AddRange(pItems, nCount);
+
+		Merge(oCopy);
+		return;
+	}
+
+	size_t nOldSize = Size();
+
+	// Make room for the new items at the end.
+	Base::AddRange(pItems, nCount);
+
+	T*     pBuffer = Base::begin();
+	size_t nDst    = nOldSize + nCount;
+	size_t nOld    = nOldSize;
+	size_t nNew    = nCount;
+
+	// Fill from the back, taking the larger item each time.
+	while (nNew != 0)
+	{
+		if ( (nOld != 0) && (m_oLess(pItems[nNew-1], pBuffer[nOld-1])) )
+			pBuffer[--nDst] = MoveItem(pBuffer[--nOld]);
+		else
+			pBuffer[--nDst] = pItems[--nNew];
+	}
+
+	BuildTree();
+}
+
+template<class T, class C>
+inline void TSortedArray<T, C>::Merge(const TArray<T>& oArray)
+{
+	Merge(oArray.begin(), oArray.Size());
+}
+
+template<class T, class C> inline void TSortedArray<T, C>::Remove(size_t nIndex)
+{
+	Base::Remove(nIndex);
+
+	BuildTree();
+}
+
+template<class T, class C>
+inline void TSortedArray<T, C>::RemoveRange(size_t nIndex, size_t nCount)
+{
+	Base::RemoveRange(nIndex, nCount);
+
+	BuildTree();
+}
+
+template<class T, class C> inline void TSortedArray<T, C>::RemoveAll()
+{
+	Base::RemoveAll();
+
+	BuildTree();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Find the index of the first item not less than the value.
+
+template<class T, class C>
+inline size_t TSortedArray<T, C>::LowerBound(const T& Item) const
+{
+	if (m_eLayout == SEARCH_EYTZINGER)
+		return TreeSearch(TLowerBoundPred<T, C>(m_oLess, Item));
+
+	return std::lower_bound(begin(), end(), Item, m_oLess) - begin();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Find the index of the first item greater than the value.
+
+template<class T, class C>
+inline size_t TSortedArray<T, C>::UpperBound(const T& Item) const
+{
+	if (m_eLayout == SEARCH_EYTZINGER)
+		return TreeSearch(TUpperBoundPred<T, C>(m_oLess, Item));
+
+	return std::upper_bound(begin(), end(), Item, m_oLess) - begin();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Find the index of the first item equal to the value or Core::npos.
+
+template<class T, class C>
+inline size_t TSortedArray<T, C>::Find(const T& Item) const
+{
+	size_t nIndex = LowerBound(Item);
+
+	if ( (nIndex == Size()) || (m_oLess(Item, *(begin() + nIndex))) )
+		return Core::npos;
+
+	return nIndex;
+}
+
+template<class T, class C>
+inline bool TSortedArray<T, C>::Contains(const T& Item) const
+{
+	return (Find(Item) != Core::npos);
+}
+
+template<class T, class C>
+inline typename TSortedArray<T, C>::const_iterator TSortedArray<T, C>::begin() const
+{
+	return Base::begin();
+}
+
+template<class T, class C>
+inline typename TSortedArray<T, C>::const_iterator TSortedArray<T, C>::end() const
+{
+	return Base::end();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Search the Eytzinger copy for the first item which the predicate is false
+// for. The descent only computes the next node, the item is found afterwards
+// by dropping the trailing right turns.
+
+template<class T, class C> template<class P>
+inline size_t TSortedArray<T, C>::TreeSearch(P oBefore) const
+{
+	const size_t nSize = Size();
+	const T*     pTree = m_vTree.begin();
+	size_t       nNode = 1;
+
+	while (nNode <= nSize)
+		nNode = (2 * nNode) + static_cast<size_t>(oBefore(pTree[nNode]));
+
+	// Undo the right turns and the final left turn.
+	while ((nNode & 1) != 0)
+		nNode >>= 1;
+
+	nNode >>= 1;
+
+	return (nNode != 0) ? m_vIndices[nNode] : nSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Rebuild the Eytzinger copy, if it's being used.
+
+template<class T, class C> inline void TSortedArray<T, C>::BuildTree()
+{
+	m_vTree.RemoveAll();
+	m_vIndices.RemoveAll();
+
+	if ( (m_eLayout != SEARCH_EYTZINGER) || (Size() == 0) )
+		return;
+
+	m_vTree.Reserve(Size()+1);
+	m_vIndices.Reserve(Size()+1);
+
+	// Node 0 is unused.
+	for (size_t i = 0; i != Size()+1; ++i)
+	{
+		m_vTree.Add(*begin());
+		m_vIndices.Add(0);
+	}
+
+	size_t nIndex = 0;
+
+	BuildTree(1, nIndex);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Fill the subtree with the next items using an in-order traversal.
+
+template<class T, class C>
+inline void TSortedArray<T, C>::BuildTree(size_t nNode, size_t& nIndex)
+{
+	if (nNode > Size())
+		return;
+
+	BuildTree(2 * nNode, nIndex);
+
+	m_vTree.Set(nNode, *(begin() + nIndex));
+	m_vIndices.Set(nNode, nIndex++);
+
+	BuildTree((2 * nNode) + 1, nIndex);
+}
+
+template<class T, class C>
+inline bool TSortedArray<T, C>::IsSorted(const T* pItems, size_t nCount) const
+{
+	for (size_t i = 1; i < nCount; ++i)
+	{
+		if (m_oLess(pItems[i], pItems[i-1]))
+			return false;
+	}
+
+	return true;
+}
+
+#endif // TSORTEDARRAY_HPP
@@ -0,0 +1,169 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		TSPAN.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The TSpan template class declaration.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef TSPAN_HPP
+#define TSPAN_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include "TypeTraits.hpp"
+
+/******************************************************************************
+**
+** This is a template class used to view a contiguous block of items owned by
+** something else, e.g. a TArray or std::vector, like std::span. The view is
+** invalidated by any change to the size of the owner.
+**
+** NB: Use TSpan<const T> for a read-only view.
+**
+*******************************************************************************
+*/
+
+template<class T> class TSpan
+{
+public:
+	//
+	// Constructors/Destructor.
+	//
+	TSpan();
+	TSpan(T* pItems, size_t nSize);
+	TSpan(const TSpan<typename TRemoveConst<T>::Type>& oSpan);
+
+	static TSpan<T> FromRange(T* pFirst, T* pLast);
+
+	//
+	// Methods.
+	//
+	size_t Size() const;
+	bool Empty() const;
+	T* Data() const;
+
+	T& At(size_t nIndex) const;
+	T& operator[](size_t nIndex) const;
+
+	TSpan<T> Subspan(size_t nIndex, size_t nCount) const;
+
+	//
+	// std::vector compatibility types and methods.
+	//
+	typedef T* iterator;
+
+	size_t size() const;
+
+	iterator begin() const;
+	iterator end() const;
+
+private:
+	//
+	// Members.
+	//
+	T*		m_pItems;	//!< The first item.
+	size_t	m_nSize;	//!< The number of items.
+};
+
+/******************************************************************************
+**
+** Implementation of TSpan inline functions.
+**
+*******************************************************************************
+*/
+
+template<class T> inline TSpan<T>::TSpan()
+	: m_pItems(NULL)
+	, m_nSize(0)
+{
+}
+
+template<class T> inline TSpan<T>::TSpan(T* pItems, size_t nSize)
+	: m_pItems(pItems)
+	, m_nSize(nSize)
+{
+	ASSERT((m_pItems != NULL) || (m_nSize == 0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Copy a span, which also converts a TSpan<T> to a TSpan<const T>. NB: Spans of
+// other types, e.g. of a derived class, are not converted as the items differ
+// in size.
+
+template<class T>
+inline TSpan<T>::TSpan(const TSpan<typename TRemoveConst<T>::Type>& oSpan)
+	: m_pItems(oSpan.Data())
+	, m_nSize(oSpan.Size())
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Create a span from the half-open range [pFirst, pLast). This is a named
+// factory rather than a constructor so that TSpan<T>(p, 0) is not ambiguous.
+
+template<class T> inline TSpan<T> TSpan<T>::FromRange(T* pFirst, T* pLast)
+{
+	ASSERT(pFirst <= pLast);
+
+	return TSpan<T>(pFirst, static_cast<size_t>(pLast - pFirst));
+}
+
+template<class T> inline size_t TSpan<T>::Size() const
+{
+	return m_nSize;
+}
+
+template<class T> inline bool TSpan<T>::Empty() const
+{
+	return (m_nSize == 0);
+}
+
+template<class T> inline T* TSpan<T>::Data() const
+{
+	return m_pItems;
+}
+
+template<class T> inline T& TSpan<T>::At(size_t nIndex) const
+{
+	ASSERT(nIndex < m_nSize);
+
+	return m_pItems[nIndex];
+}
+
+template<class T> inline T& TSpan<T>::operator[](size_t nIndex) const
+{
+	ASSERT(nIndex < m_nSize);
+
+	return m_pItems[nIndex];
+}
+
+template<class T> inline TSpan<T> TSpan<T>::Subspan(size_t nIndex, size_t nCount) const
+{
+	ASSERT(nIndex <= m_nSize);
+	ASSERT(nCount <= (m_nSize - nIndex));
+
+	return TSpan<T>(m_pItems + nIndex, nCount);
+}
+
+template<class T> inline size_t TSpan<T>::size() const
+{
+	return m_nSize;
+}
+
+template<class T> inline typename TSpan<T>::iterator TSpan<T>::begin() const
+{
+	return m_pItems;
+}
+
+template<class T> inline typename TSpan<T>::iterator TSpan<T>::end() const
+{
+	return m_pItems + m_nSize;
+}
+
+#endif // TSPAN_HPP
@@ -0,0 +1,298 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		TSTRINGARRAY.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The TStringArray template class declaration.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef TSTRINGARRAY_HPP
+#define TSTRINGARRAY_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include "TArray.hpp"
+#include <string>
+
+/******************************************************************************
+**
+** This is a template class used for large arrays of strings, e.g. file names.
+** The characters of all the strings are appended to a single buffer, each one
+** null terminated, and the strings are indexed by their offset, so adding a
+** string does not allocate once the buffers have grown.
+**
+** Strings are compared by character code, like strcmp(), using the CRT's
+** memcmp()/wmemcmp() which is vectorised.
+**
+*******************************************************************************
+*/
+
+template<class C = tchar> class TStringArray
+{
+public:
+	//
+	// Constructors/Destructor.
+	//
+	TStringArray();
+	~TStringArray();
+
+	//
+	// Methods.
+	//
+	size_t Size() const;
+	size_t Length(size_t nIndex) const;
+	size_t NumChars() const;
+
+	void Reserve(size_t nSize, size_t nChars);
+
+	TSpan<const C> At(size_t nIndex) const;
+	TSpan<const C> operator[](size_t nIndex) const;
+	const C* CStr(size_t nIndex) const;
+
+	size_t Add(const C* pszString);
+	size_t Add(const C* pChars, size_t nLength);
+	size_t AddRange(const TStringArray<C>& oArray);
+	void RemoveAll();
+
+	int Compare(size_t nIndex1, size_t nIndex2) const;
+	bool Equals(size_t nIndex, const C* pChars, size_t nLength) const;
+	size_t Find(const C* pszString) const;
+
+	void GetSortedOrder(TArray<size_t>& vOrder) const;
+	void Sort();
+
+private:
+	// Template shorthands.
+	typedef std::char_traits<C> Traits;
+
+	// The predicate used to sort the string indices.
+	struct Less
+	{
+		Less(const TStringArray<C>& oArray)
+			: m_oArray(oArray)
+		{ }
+
+		bool operator()(size_t nIndex1, size_t nIndex2) const
+		{
+			return (m_oArray.Compare(nIndex1, nIndex2) < 0);
+		}
+
+		const TStringArray<C>& m_oArray;
+	};
+
+	//
+	// Members.
+	//
+	TArray<C>		m_vChars;		//!< The characters of all the strings.
+	TArray<size_t>	m_vOffsets;		//!< The offset of each string.
+
+	// Disallow copies for now.
+	TStringArray(const TStringArray<C>&);
+	void operator=(const TStringArray<C>&);
+};
+
+/******************************************************************************
+**
+** Implementation of TStringArray inline functions.
+**
+*******************************************************************************
+*/
+
+template<class C> inline TStringArray<C>::TStringArray()
+	: m_vChars()
+	, m_vOffsets()
+{
+}
+
+template<class C> inline TStringArray<C>::~TStringArray()
+{
+}
+
+template<class C> inline size_t TStringArray<C>::Size() const
+{
+	return m_vOffsets.Size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Get the length of a string, which is the distance to the next one less the
+// null terminator.
+
+template<class C> inline size_t TStringArray<C>::Length(size_t nIndex) const
+{
+	ASSERT(nIndex < Size());
+
+	size_t nEnd = (nIndex+1 < Size()) ? m_vOffsets[nIndex+1] : m_vChars.Size();
+
+	return nEnd - m_vOffsets[nIndex] - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Get the number of characters stored, including the null terminators.
+
+template<class C> inline size_t TStringArray<C>::NumChars() const
+{
+	return m_vChars.Size();
+}
+
+template<class C> inline void TStringArray<C>::Reserve(size_t nSize, size_t nChars)
+{
+	m_vOffsets.Reserve(nSize);
+	m_vChars.Reserve(nChars);
+}
+
+template<class C> inline TSpan<const C> TStringArray<C>::At(size_t nIndex) const
+{
+	return TSpan<const C>(CStr(nIndex), Length(nIndex));
+}
+
+template<class C> inline TSpan<const C> TStringArray<C>::operator[](size_t nIndex) const
+{
+	return At(nIndex);
+}
+
+template<class C> inline const C* TStringArray<C>::CStr(size_t nIndex) const
+{
+	ASSERT(nIndex < Size());
+
+	return m_vChars.begin() + m_vOffsets[nIndex];
+}
+
+template<class C> inline size_t TStringArray<C>::Add(const C* pszString)
+{
+	ASSERT(pszString != NULL);
+
+	return Add(pszString, Traits::length(pszString));
+}
+
+template<class C> inline size_t TStringArray<C>::Add(const C* pChars, size_t nLength)
+{
+	ASSERT((pChars != NULL) || (nLength == 0));
+
+	m_vOffsets.Add(m_vChars.Size());
+
+	m_vChars.AddRange(pChars, nLength);
+	m_vChars.Add(C());
+
+	return m_vOffsets.Size()-1;
+}
+
+template<class C> inline size_t TStringArray<C>::AddRange(const TStringArray<C>& oArray)
+{
+	size_t nIndex = Size();
+	size_t nBase  = m_vChars.Size();
+	size_t nCount = oArray.Size();	// Fixed as oArray may be this array.
+
+	m_vOffsets.Reserve(nIndex + nCount);
+
+	for (size_t i = 0; i != nCount; ++i)
+		m_vOffsets.Add(nBase + oArray.m_vOffsets[i]);
+
+	m_vChars.AddRange(oArray.m_vChars);
+
+	return nIndex;
+}
+
+template<class C> inline void TStringArray<C>::RemoveAll()
+{
+	m_vOffsets.RemoveAll();
+	m_vChars.RemoveAll();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Compare two strings by character code. Returns < 0, 0 or > 0.
+
+template<class C> inline int TStringArray<C>::Compare(size_t nIndex1, size_t nIndex2) const
+{
+	size_t nLength1 = Length(nIndex1);
+	size_t nLength2 = Length(nIndex2);
+	size_t nCommon  = (nLength1 < nLength2) ? nLength1 : nLength2;
+
+	int nResult = Traits::compare(CStr(nIndex1), CStr(nIndex2), nCommon);
+
+	if (nResult != 0)
+		return nResult;
+
+	return (nLength1 < nLength2) ? -1 : ((nLength1 > nLength2) ? 1 : 0);
+}
+
+template<class C> inline bool TStringArray<C>::Equals(size_t nIndex, const C* pChars, size_t nLength) const
+{
+	return (Length(nIndex) == nLength) && (Traits::compare(CStr(nIndex), pChars, nLength) == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Find the first string equal to the value or Core::npos. Only the strings of
+// the same length are compared, which are found from the offsets.
+
+template<class C> inline size_t TStringArray<C>::Find(const C* pszString) const
+{
+	ASSERT(pszString != NULL);
+
+	size_t        nLength  = Traits::length(pszString);
+	const size_t* pOffsets = m_vOffsets.begin();
+	const C*      pChars   = m_vChars.begin();
+
+	for (size_t i = 0; i != Size(); ++i)
+	{
+		size_t nEnd = (i+1 < Size()) ? pOffsets[i+1] : m_vChars.Size();
+
+		if ( ((nEnd - pOffsets[i] - 1) == nLength)
+		  && (Traits::compare(pChars + pOffsets[i], pszString, nLength) == 0) )
+			return i;
+	}
+
+	return Core::npos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Get the indices of the strings in sorted order, without moving any of them.
+
+template<class C> inline void TStringArray<C>::GetSortedOrder(TArray<size_t>& vOrder) const
+{
+	vOrder.RemoveAll();
+	vOrder.Reserve(Size());
+
+	for (size_t i = 0; i != Size(); ++i)
+		vOrder.Add(i);
+
+	std::sort(vOrder.begin(), vOrder.end(), Less(*this));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Sort the strings. Only the indices are sorted and then the characters are
+// copied once, in order, into a new buffer.
+
+template<class C> inline void TStringArray<C>::Sort()
+{
+	TArray<size_t> vOrder;
+
+	GetSortedOrder(vOrder);
+
+	TArray<C>      vChars;
+	TArray<size_t> vOffsets;
+
+	vChars.Reserve(m_vChars.Size());
+	vOffsets.Reserve(Size());
+
+	for (size_t i = 0; i != vOrder.Size(); ++i)
+	{
+		vOffsets.Add(vChars.Size());
+		vChars.AddRange(CStr(vOrder[i]), Length(vOrder[i]) + 1);
+	}
+
+	size_t nSize, nCapacity;
+
+	// Swap in the new buffers.
+	C* pChars = vChars.Detach(nSize, nCapacity);
+	m_vChars.Attach(pChars, nSize, nCapacity);
+
+	size_t* pOffsets = vOffsets.Detach(nSize, nCapacity);
+	m_vOffsets.Attach(pOffsets, nSize, nCapacity);
+}
+
+#endif // TSTRINGARRAY_HPP
@@ -0,0 +1,171 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		TTOPK.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The TTopK template class declaration.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef TTOPK_HPP
+#define TTOPK_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include "TArray.hpp"
+#include <functional>
+
+/******************************************************************************
+**
+** This is a template class used to keep the K greatest items of a stream, as
+** ordered by the "less than" predicate, without storing the entire stream.
+** The items are kept in a heap with the least of them at the top, so each
+** item added is O(log K) at worst and O(1) if it is not in the top K.
+**
+*******************************************************************************
+*/
+
+template<class T, class C = std::less<T> > class TTopK
+{
+public:
+	//
+	// Constructors/Destructor.
+	//
+	explicit TTopK(size_t nCount);
+	TTopK(size_t nCount, C oLess);
+	~TTopK();
+
+	//
+	// Methods.
+	//
+	size_t Size() const;
+	size_t Capacity() const;
+
+	bool Add(const T& Item);
+	void RemoveAll();
+
+	T Least() const;
+	void GetItems(TArray<T>& oArray) const;
+
+private:
+	// The predicate used to order the heap by least first.
+	struct Greater
+	{
+		Greater(const C& oLess)
+			: m_oLess(oLess)
+		{ }
+
+		bool operator()(const T& Item1, const T& Item2) const
+		{
+			return m_oLess(Item2, Item1);
+		}
+
+		C	m_oLess;
+	};
+
+	//
+	// Members.
+	//
+	Greater		m_oGreater;		//!< The heap predicate.
+	size_t		m_nCount;		//!< The number of items to keep.
+	TArray<T>	m_vHeap;		//!< The items.
+
+	// Disallow copies for now.
+	TTopK(const TTopK<T, C>&);
+	void operator=(const TTopK<T, C>&);
+};
+
+/******************************************************************************
+**
+** Implementation of TTopK inline functions.
+**
+*******************************************************************************
+*/
+
+template<class T, class C> inline TTopK<T, C>::TTopK(size_t nCount)
+	: m_oGreater(C())
+	, m_nCount(nCount)
+	, m_vHeap()
+{
+	m_vHeap.Reserve(m_nCount);
+}
+
+template<class T, class C> inline TTopK<T, C>::TTopK(size_t nCount, C oLess)
+	: m_oGreater(oLess)
+	, m_nCount(nCount)
+	, m_vHeap()
+{
+	m_vHeap.Reserve(m_nCount);
+}
+
+template<class T, class C> inline TTopK<T, C>::~TTopK()
+{
+}
+
+template<class T, class C> inline size_t TTopK<T, C>::Size() const
+{
+	return m_vHeap.Size();
+}
+
+template<class T, class C> inline size_t TTopK<T, C>::Capacity() const
+{
+	return m_nCount;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Add an item if it is one of the K greatest so far, replacing the least of
+// them when full. Returns true if the item was kept.
+
+template<class T, class C> inline bool TTopK<T, C>::Add(const T& Item)
+{
+	if (m_vHeap.Size() < m_nCount)
+	{
+		m_vHeap.Add(Item);
+		std::push_heap(m_vHeap.begin(), m_vHeap.end(), m_oGreater);
+
+		return true;
+	}
+
+	// Not greater than the least kept?
+	if ( (m_nCount == 0) || (!m_oGreater.m_oLess(*m_vHeap.begin(), Item)) )
+		return false;
+
+	std::pop_heap(m_vHeap.begin(), m_vHeap.end(), m_oGreater);
+	m_vHeap.Set(m_vHeap.Size()-1, Item);
+	std::push_heap(m_vHeap.begin(), m_vHeap.end(), m_oGreater);
+
+	return true;
+}
+
+template<class T, class C> inline void TTopK<T, C>::RemoveAll()
+{
+	m_vHeap.RemoveRange(0, m_vHeap.Size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Get the least of the items kept, i.e. the threshold for adding an item.
+
+template<class T, class C> inline T TTopK<T, C>::Least() const
+{
+	ASSERT(m_vHeap.Size() > 0);
+
+	return *m_vHeap.begin();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Append the items kept to an array, greatest first.
+
+template<class T, class C> inline void TTopK<T, C>::GetItems(TArray<T>& oArray) const
+{
+	size_t nFirst = oArray.Size();
+
+	oArray.AddRange(m_vHeap);
+
+	std::sort_heap(oArray.begin() + nFirst, oArray.end(), m_oGreater);
+}
+
+#endif // TTOPK_HPP
@@ -16,7 +16,7 @@
 #pragma once
 #endif
 
-#include "TArray.hpp"
+#include "TSmallArray.hpp"
 
 /******************************************************************************
 ** 
@@ -54,8 +54,11 @@ public:
 	T	m_oData;
 
 protected:
+	// The number of child nodes stored without a heap allocation.
+	enum { INLINE_NODES = 4 };
+
 	// Template typedefs.
-	typedef TPtrArray<TTreeNode> CNodes;
+	typedef TSmallArray<TTreeNode*, INLINE_NODES> CNodes;
 
 	//
 	// Members.
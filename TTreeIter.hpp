@@ -16,6 +16,8 @@
 #pragma once
 #endif
 
+#include "TRingArray.hpp"
+
 /******************************************************************************
 ** 
 ** The template version of the tree forward iterator.
@@ -41,7 +43,7 @@ public:
 private:
 	// Template shorthands.
 	typedef TTreeFwdIter<T>	 CIter;
-	typedef TPtrArray<CIter> CIterStack;
+	typedef TRingArray<CIter*> CIterStack;
 
 	//
 	// Members.
@@ -76,7 +78,8 @@ template<class T> inline TTreeFwdIter<T>::TTreeFwdIter(TTreeNode<T>* pNode)
 template<class T> inline TTreeFwdIter<T>::~TTreeFwdIter()
 {
 	// Cleanup stack.
-	m_vIterStack.DeleteAll();
+	while (!m_vIterStack.Empty())
+		delete m_vIterStack.PopFront();
 }
 
 template<class T> inline TTreeNode<T>* TTreeFwdIter<T>::Next()
@@ -90,7 +93,7 @@ template<class T> inline TTreeNode<T>* TTreeFwdIter<T>::Next()
 
 		// Populate iterator stack...
 		for (size_t i = 0; i < m_pNode->NumNodes(); ++i)
-			m_vIterStack.Add(new CIter(m_pNode->Node(i)));
+			m_vIterStack.PushBack(new CIter(m_pNode->Node(i)));
 
 		m_pNode = NULL;
 	}
@@ -99,8 +102,8 @@ template<class T> inline TTreeNode<T>* TTreeFwdIter<T>::Next()
 	while ( (pNode == NULL) && (m_vIterStack.Size() > 0) )
 	{
 		// Query top iterator.
-		if ((pNode = m_vIterStack[0]->Next()) == NULL)
-			m_vIterStack.Delete(0);
+		if ((pNode = m_vIterStack.Front()->Next()) == NULL)
+			delete m_vIterStack.PopFront();
 	}
 
 	return pNode;
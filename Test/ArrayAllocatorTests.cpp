@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   ArrayAllocatorTests.cpp
+//! \brief  The unit tests for the array allocator classes.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TSmallArray.hpp>
+#include <Legacy/ArrayAllocator.hpp>
+
+namespace
+{
+
+//! Check if an array holds the values 0..N-1 scaled by a factor.
+bool HasValues(const TArray<int>& vArray, int nFactor)
+{
+	for (size_t i = 0; i != vArray.Size(); ++i)
+	{
+		if (vArray[i] != (static_cast<int>(i) * nFactor))
+			return false;
+	}
+
+	return true;
+}
+
+}
+
+TEST_SET(ArrayAllocator)
+{
+
+TEST_CASE("An aligned allocator keeps the buffer aligned as it grows and shrinks")
+{
+	CAlignedAllocator oAllocator(64);
+	TArray<float>     vArray(oAllocator);
+
+	bool bAligned = true;
+
+	for (int i = 0; i != 1000; ++i)
+	{
+		vArray.Add(static_cast<float>(i));
+
+		bAligned = bAligned && ((reinterpret_cast<size_t>(vArray.begin()) % 64) == 0);
+	}
+
+	TEST_TRUE(bAligned);
+	TEST_TRUE(vArray[999] == 999.0f);
+
+	vArray.RemoveRange(10, 990);
+	vArray.ShrinkToFit();
+
+	TEST_TRUE((reinterpret_cast<size_t>(vArray.begin()) % 64) == 0);
+	TEST_TRUE((vArray.Size() == 10) && (vArray[9] == 9.0f));
+}
+TEST_CASE_END
+
+TEST_CASE("Arrays sharing an arena keep their own items")
+{
+	CArenaAllocator oAllocator(1024);
+	TArray<int>     vArray1(oAllocator);
+	TArray<int>     vArray2(oAllocator);
+
+	for (int i = 0; i != 5000; ++i)
+	{
+		vArray1.Add(i);
+		vArray2.Add(-i);
+	}
+
+	TEST_TRUE(HasValues(vArray1, 1));
+	TEST_TRUE(HasValues(vArray2, -1));
+
+	vArray1.RemoveAll();
+	vArray2.RemoveAll();
+}
+TEST_CASE_END
+
+TEST_CASE("A pool allocator recycles the buffers of earlier arrays")
+{
+	CPoolAllocator oAllocator;
+
+	for (int r = 0; r != 3; ++r)
+	{
+		TArray<int> vArray(oAllocator);
+
+		for (int i = 0; i != 10000; ++i)
+			vArray.Add(i);
+
+		TEST_TRUE(HasValues(vArray, 1));
+	}
+
+	oAllocator.Purge();
+}
+TEST_CASE_END
+
+TEST_CASE("Changing the allocator moves the items to a new buffer")
+{
+	CPoolAllocator      oAllocator;
+	TSmallArray<int, 4> vArray;
+
+	for (int i = 0; i != 100; ++i)
+		vArray.Add(i);
+
+	vArray.SetAllocator(&oAllocator);
+
+	TEST_TRUE(HasValues(vArray, 1));
+
+	vArray.SetAllocator(NULL);
+	vArray.RemoveRange(2, 98);
+	vArray.ShrinkToFit();
+
+	TEST_TRUE(vArray.Capacity() == 4);
+	TEST_TRUE(HasValues(vArray, 1));
+}
+TEST_CASE_END
+
+TEST_CASE("A virtual memory buffer can grow, shrink and be copied")
+{
+	CVirtualAllocator oAllocator(4096, 1024 * 1024);
+	TArray<int>       vArray(oAllocator);
+
+	for (int i = 0; i != 200000; ++i)
+		vArray.Add(i);
+
+	TEST_TRUE(vArray.Size() == 200000);
+	TEST_TRUE(HasValues(vArray, 1));
+
+	vArray.RemoveRange(10, vArray.Size() - 10);
+	vArray.ShrinkToFit();
+
+	TEST_TRUE((vArray.Size() == 10) && HasValues(vArray, 1));
+
+	for (int i = 10; i != 5000; ++i)
+		vArray.Add(i);
+
+	TArray<int> vCopy(vArray);
+
+	vCopy.Add(0);
+
+	TEST_TRUE((vCopy.Size() == 5001) && (vArray.Size() == 5000));
+	TEST_TRUE(HasValues(vArray, 1));
+}
+TEST_CASE_END
+
+TEST_CASE("Buffers below the virtual memory threshold use the heap")
+{
+	CVirtualAllocator oAllocator;
+	TArray<int>       vArray(oAllocator);
+
+	for (int i = 0; i != 100; ++i)
+		vArray.Add(i);
+
+	TEST_TRUE(HasValues(vArray, 1));
+
+	vArray.RemoveAll();
+	vArray.ShrinkToFit();
+
+	TEST_TRUE(vArray.Capacity() == 0);
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
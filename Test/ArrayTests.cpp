@@ -0,0 +1,270 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   ArrayTests.cpp
+//! \brief  The unit tests for the TArray class.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TArray.hpp>
+
+static bool IsOdd(int nValue)
+{
+	return ((nValue % 2) != 0);
+}
+
+TEST_SET(Array)
+{
+
+TEST_CASE("A default constructed array is empty and has no buffer")
+{
+	TArray<int> vArray;
+
+	TEST_TRUE(vArray.Size() == 0);
+	TEST_TRUE(vArray.Capacity() == 0);
+	TEST_TRUE(vArray.begin() == vArray.end());
+}
+TEST_CASE_END
+
+TEST_CASE("The geometric policy grows the capacity by half in multiples of 4")
+{
+	TArray<int> vArray;
+
+	vArray.Add(1);
+
+	TEST_TRUE(vArray.Capacity() == 4);
+
+	for (int i = 1; i != 5; ++i)
+		vArray.Add(i);
+
+	TEST_TRUE(vArray.Size() == 5);
+	TEST_TRUE(vArray.Capacity() == 8);
+
+	for (int i = 5; i != 9; ++i)
+		vArray.Add(i);
+
+	TEST_TRUE(vArray.Capacity() == 12);
+}
+TEST_CASE_END
+
+TEST_CASE("The fixed policy grows the capacity to a multiple of the step")
+{
+	TArray<int> vArray(CArray::GROW_FIXED, 10);
+
+	vArray.Add(1);
+
+	TEST_TRUE(vArray.Capacity() == 10);
+
+	for (int i = 1; i != 11; ++i)
+		vArray.Add(i);
+
+	TEST_TRUE(vArray.Size() == 11);
+	TEST_TRUE(vArray.Capacity() == 20);
+}
+TEST_CASE_END
+
+TEST_CASE("The exact policy grows the capacity to the size required")
+{
+	TArray<int> vArray(CArray::GROW_EXACT);
+
+	for (int i = 0; i != 7; ++i)
+	{
+		vArray.Add(i);
+
+		TEST_TRUE(vArray.Capacity() == vArray.Size());
+	}
+}
+TEST_CASE_END
+
+TEST_CASE("Reserving space never reduces the capacity or changes the size")
+{
+	TArray<int> vArray;
+
+	vArray.Reserve(100);
+
+	TEST_TRUE(vArray.Size() == 0);
+	TEST_TRUE(vArray.Capacity() >= 100);
+
+	size_t nCapacity = vArray.Capacity();
+
+	vArray.Reserve(10);
+
+	TEST_TRUE(vArray.Capacity() == nCapacity);
+}
+TEST_CASE_END
+
+TEST_CASE("Shrinking to fit releases the unused space")
+{
+	TArray<int> vArray;
+
+	vArray.Reserve(100);
+	vArray.Add(1);
+	vArray.Add(2);
+	vArray.ShrinkToFit();
+
+	TEST_TRUE(vArray.Capacity() == 2);
+	TEST_TRUE((vArray[0] == 1) && (vArray[1] == 2));
+
+	vArray.RemoveAll();
+	vArray.ShrinkToFit();
+
+	TEST_TRUE(vArray.Capacity() == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("Changing the growth policy keeps the existing items")
+{
+	TArray<int> vArray;
+
+	for (int i = 0; i != 12; ++i)
+		vArray.Add(i);
+
+	TEST_TRUE(vArray.Capacity() == 12);
+
+	vArray.SetGrowthPolicy(CArray::GROW_FIXED, 100);
+	vArray.Add(12);
+
+	TEST_TRUE(vArray.Capacity() == 100);
+
+	for (int i = 0; i != 13; ++i)
+		TEST_TRUE(vArray[i] == i);
+}
+TEST_CASE_END
+
+TEST_CASE("Adding a range appends the items in order")
+{
+	const int aItems[] = { 1, 2, 3, 4, 5 };
+
+	TArray<int> vArray;
+
+	TEST_TRUE(vArray.AddRange(aItems, 5) == 0);
+	TEST_TRUE(vArray.AddRange(aItems, 2) == 5);
+	TEST_TRUE(vArray.Size() == 7);
+
+	for (size_t i = 0; i != 5; ++i)
+		TEST_TRUE(vArray[i] == aItems[i]);
+
+	TEST_TRUE((vArray[5] == 1) && (vArray[6] == 2));
+}
+TEST_CASE_END
+
+TEST_CASE("Adding or inserting an empty range does nothing")
+{
+	TArray<int> vArray;
+
+	vArray.AddRange(NULL, 0);
+	vArray.InsertRange(0, static_cast<const int*>(NULL), static_cast<const int*>(NULL));
+
+	TEST_TRUE(vArray.Size() == 0);
+	TEST_TRUE(vArray.Capacity() == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("Inserting a range moves the existing items up")
+{
+	const int aItems[] = { 10, 11, 12 };
+
+	TArray<int> vArray;
+
+	for (int i = 0; i != 4; ++i)
+		vArray.Add(i);
+
+	vArray.InsertRange(2, aItems, aItems+3);
+
+	const int aExpected[] = { 0, 1, 10, 11, 12, 2, 3 };
+
+	TEST_TRUE(vArray.Size() == 7);
+
+	for (size_t i = 0; i != 7; ++i)
+		TEST_TRUE(vArray[i] == aExpected[i]);
+
+	vArray.InsertRange(0, aItems, aItems+1);
+	vArray.InsertRange(vArray.Size(), aItems+2, aItems+3);
+
+	TEST_TRUE((vArray[0] == 10) && (vArray[8] == 12) && (vArray.Size() == 9));
+}
+TEST_CASE_END
+
+TEST_CASE("Adding an array to itself doubles the items")
+{
+	TArray<int> vArray;
+
+	for (int i = 0; i != 4; ++i)
+		vArray.Add(i);
+
+	vArray.ShrinkToFit();
+	vArray.AddRange(vArray);
+
+	TEST_TRUE(vArray.Size() == 8);
+
+	for (int i = 0; i != 8; ++i)
+		TEST_TRUE(vArray[i] == (i % 4));
+}
+TEST_CASE_END
+
+TEST_CASE("Inserting an overlapping range from the same array copies the original items")
+{
+	TArray<int> vArray;
+
+	for (int i = 0; i != 6; ++i)
+		vArray.Add(i);
+
+	vArray.ShrinkToFit();
+	vArray.InsertRange(1, vArray.begin()+2, vArray.begin()+5);
+
+	const int aExpected[] = { 0, 2, 3, 4, 1, 2, 3, 4, 5 };
+
+	TEST_TRUE(vArray.Size() == 9);
+
+	for (size_t i = 0; i != 9; ++i)
+		TEST_TRUE(vArray[i] == aExpected[i]);
+}
+TEST_CASE_END
+
+TEST_CASE("Removing a range closes the gap")
+{
+	TArray<int> vArray;
+
+	for (int i = 0; i != 10; ++i)
+		vArray.Add(i);
+
+	vArray.RemoveRange(2, 3);
+
+	const int aExpected[] = { 0, 1, 5, 6, 7, 8, 9 };
+
+	TEST_TRUE(vArray.Size() == 7);
+
+	for (size_t i = 0; i != 7; ++i)
+		TEST_TRUE(vArray[i] == aExpected[i]);
+
+	vArray.RemoveRange(5, 2);
+
+	TEST_TRUE((vArray.Size() == 5) && (vArray[4] == 7));
+
+	vArray.RemoveRange(vArray.Size(), 0);
+	vArray.RemoveRange(0, vArray.Size());
+
+	TEST_TRUE(vArray.Size() == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("Removing items that match a predicate keeps the rest in order")
+{
+	TArray<int> vArray;
+
+	TEST_TRUE(vArray.RemoveIf(IsOdd) == 0);
+
+	for (int i = 0; i != 10; ++i)
+		vArray.Add(i);
+
+	TEST_TRUE(vArray.RemoveIf(IsOdd) == 5);
+	TEST_TRUE(vArray.Size() == 5);
+
+	for (int i = 0; i != 5; ++i)
+		TEST_TRUE(vArray[i] == (i * 2));
+
+	TEST_TRUE(vArray.RemoveIf(IsOdd) == 0);
+	TEST_TRUE(vArray.Size() == 5);
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
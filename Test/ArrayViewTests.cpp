@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   ArrayViewTests.cpp
+//! \brief  The unit tests for TArray::Save() and the TArrayView class.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TArray.hpp>
+#include <Legacy/TArrayView.hpp>
+
+namespace
+{
+
+//! A trivially copyable record.
+struct Record
+{
+	int		m_nKey;
+	double	m_dValue;
+};
+
+//! The file used by the tests.
+const tchar* TEST_FILE = TXT("ArrayViewTests.tmp");
+
+//! The type tag used to save the records.
+const uint RECORD_TAG = 42;
+
+}
+
+TEST_SET(ArrayView)
+{
+
+TEST_CASE("A view is closed until a file is opened")
+{
+	TArrayView<int> vView;
+
+	TEST_FALSE(vView.IsOpen());
+	TEST_TRUE(vView.Size() == 0);
+	TEST_TRUE(vView.begin() == vView.end());
+}
+TEST_CASE_END
+
+TEST_CASE("A saved array can be read back through a view")
+{
+	TArray<Record> vArray;
+
+	for (int i = 0; i != 10007; ++i)
+	{
+		Record oRecord = { i, i * 0.5 };
+
+		vArray.Add(oRecord);
+	}
+
+	TEST_TRUE(vArray.Save(TEST_FILE, RECORD_TAG));
+
+	TArrayView<Record> vView;
+
+	TEST_TRUE(vView.Open(TEST_FILE, RECORD_TAG));
+	TEST_TRUE(vView.IsOpen());
+	TEST_TRUE(vView.Size() == vArray.Size());
+
+	bool bSame = true;
+
+	for (size_t i = 0; i != vView.Size(); ++i)
+		bSame = bSame && (vView[i].m_nKey == vArray[i].m_nKey) && (vView.At(i).m_dValue == vArray[i].m_dValue);
+
+	TEST_TRUE(bSame);
+	TEST_TRUE(static_cast<size_t>(vView.end() - vView.begin()) == vView.size());
+
+	vView.Close();
+
+	TEST_FALSE(vView.IsOpen());
+
+	::DeleteFile(TEST_FILE);
+}
+TEST_CASE_END
+
+TEST_CASE("An empty array can be saved and viewed")
+{
+	TArray<int> vArray;
+
+	TEST_TRUE(vArray.Save(TEST_FILE));
+
+	TArrayView<int> vView;
+
+	TEST_TRUE(vView.Open(TEST_FILE));
+	TEST_TRUE(vView.Size() == 0);
+	TEST_TRUE(vView.begin() == vView.end());
+
+	vView.Close();
+
+	::DeleteFile(TEST_FILE);
+}
+TEST_CASE_END
+
+TEST_CASE("Opening a file with the wrong type tag, item size or path fails")
+{
+	TArray<Record> vArray;
+	Record         oRecord = { 1, 1.0 };
+
+	vArray.Add(oRecord);
+
+	TEST_TRUE(vArray.Save(TEST_FILE, RECORD_TAG));
+
+	TArrayView<Record> vRecords;
+	TArrayView<int>    vInts;
+
+	TEST_FALSE(vRecords.Open(TEST_FILE, RECORD_TAG + 1));
+	TEST_FALSE(vRecords.IsOpen());
+	TEST_TRUE(vRecords.Size() == 0);
+
+	TEST_FALSE(vInts.Open(TEST_FILE, RECORD_TAG));
+	TEST_FALSE(vInts.IsOpen());
+
+	::DeleteFile(TEST_FILE);
+
+	TEST_FALSE(vRecords.Open(TEST_FILE, RECORD_TAG));
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
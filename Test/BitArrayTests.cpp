@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   BitArrayTests.cpp
+//! \brief  The unit tests for the CBitArray class.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/BitArray.hpp>
+
+namespace
+{
+
+//! Count the set bits one at a time.
+size_t CountEachBit(const CBitArray& oArray)
+{
+	size_t nCount = 0;
+
+	for (size_t i = 0; i != oArray.Size(); ++i)
+	{
+		if (oArray.Test(i))
+			++nCount;
+	}
+
+	return nCount;
+}
+
+//! Set every Nth bit.
+void SetEvery(CBitArray& oArray, size_t nStep)
+{
+	for (size_t i = 0; i < oArray.Size(); i += nStep)
+		oArray.Set(i);
+}
+
+}
+
+TEST_SET(BitArray)
+{
+
+TEST_CASE("An empty bit array has no bits set")
+{
+	CBitArray oArray;
+
+	TEST_TRUE(oArray.Size() == 0);
+	TEST_TRUE(oArray.Count() == 0);
+	TEST_TRUE(oArray.FindFirstSet() == Core::npos);
+
+	oArray.SetAll();
+
+	TEST_TRUE(oArray.Count() == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("Bits can be set, tested and cleared individually")
+{
+	CBitArray oArray(130);
+
+	oArray.Set(0);
+	oArray.Set(63);
+	oArray.Set(64);
+	oArray.Set(129);
+
+	TEST_TRUE(oArray.Test(0) && oArray[63] && oArray[64] && oArray[129]);
+	TEST_FALSE(oArray.Test(1) || oArray[62] || oArray[65] || oArray[128]);
+	TEST_TRUE(oArray.Count() == 4);
+
+	oArray.Clear(63);
+	oArray.Set(64, false);
+
+	TEST_FALSE(oArray[63] || oArray[64]);
+	TEST_TRUE(oArray.Count() == 2);
+}
+TEST_CASE_END
+
+TEST_CASE("Setting all the bits leaves the unused bits in the last word clear")
+{
+	for (size_t nSize = 1; nSize != 200; ++nSize)
+	{
+		CBitArray oArray(nSize);
+
+		oArray.SetAll();
+
+		TEST_TRUE(oArray.Count() == nSize);
+
+		oArray.ClearAll();
+
+		TEST_TRUE(oArray.Count() == 0);
+	}
+}
+TEST_CASE_END
+
+TEST_CASE("The bit count matches counting each bit for every size")
+{
+	for (size_t nSize = 0; nSize != 300; ++nSize)
+	{
+		CBitArray oArray(nSize);
+
+		SetEvery(oArray, 3);
+
+		TEST_TRUE(oArray.Count() == CountEachBit(oArray));
+	}
+
+	CBitArray oLarge(100000);
+
+	SetEvery(oLarge, 7);
+
+	TEST_TRUE(oLarge.Count() == CountEachBit(oLarge));
+}
+TEST_CASE_END
+
+TEST_CASE("The set bits can be iterated in order")
+{
+	CBitArray oArray(1000);
+
+	const size_t aBits[] = { 0, 1, 63, 64, 127, 500, 999 };
+	const size_t nBits = sizeof(aBits) / sizeof(aBits[0]);
+
+	for (size_t i = 0; i != nBits; ++i)
+		oArray.Set(aBits[i]);
+
+	size_t nFound = 0;
+
+	for (size_t nIndex = oArray.FindFirstSet(); nIndex != Core::npos; nIndex = oArray.FindNextSet(nIndex))
+	{
+		TEST_TRUE((nFound < nBits) && (nIndex == aBits[nFound]));
+		++nFound;
+	}
+
+	TEST_TRUE(nFound == nBits);
+}
+TEST_CASE_END
+
+TEST_CASE("Shrinking clears the bits removed so that growing again doesn't restore them")
+{
+	CBitArray oArray(200);
+
+	oArray.SetAll();
+	oArray.Resize(70);
+
+	TEST_TRUE(oArray.Count() == 70);
+
+	oArray.Resize(200);
+
+	TEST_TRUE(oArray.Size() == 200);
+	TEST_TRUE(oArray.Count() == 70);
+	TEST_FALSE(oArray[70]);
+
+	oArray.Resize(0);
+
+	TEST_TRUE(oArray.Count() == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("The logical operations combine arrays of the same size")
+{
+	CBitArray oTwos(150);
+	CBitArray oThrees(150);
+
+	SetEvery(oTwos, 2);
+	SetEvery(oThrees, 3);
+
+	CBitArray oAnd(oTwos);
+	oAnd.And(oThrees);
+
+	CBitArray oOr(oTwos);
+	oOr.Or(oThrees);
+
+	CBitArray oXor(oTwos);
+	oXor.Xor(oThrees);
+
+	CBitArray oAndNot(oTwos);
+	oAndNot.AndNot(oThrees);
+
+	for (size_t i = 0; i != 150; ++i)
+	{
+		bool bTwo   = ((i % 2) == 0);
+		bool bThree = ((i % 3) == 0);
+
+		TEST_TRUE(oAnd[i] == (bTwo && bThree));
+		TEST_TRUE(oOr[i] == (bTwo || bThree));
+		TEST_TRUE(oXor[i] == (bTwo != bThree));
+		TEST_TRUE(oAndNot[i] == (bTwo && !bThree));
+	}
+
+	TEST_TRUE(oTwos.Count() == 75);
+	TEST_TRUE(oThrees.Count() == 50);
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
@@ -0,0 +1,20 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   Common.hpp
+//! \brief  Wrapper to include the most common test harness headers.
+//! \author Chris Oldwood
+
+// Check for previous inclusion
+#ifndef TEST_COMMON_HPP
+#define TEST_COMMON_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Library headers.
+
+#include <Legacy/Common.hpp>	// Legacy library common headers.
+#include <Core/UnitTest.hpp>	// Core library unit test macros.
+
+#endif // TEST_COMMON_HPP
@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   ConcurrentArrayTests.cpp
+//! \brief  The unit tests for the TConcurrentArray class.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TConcurrentArray.hpp>
+#include <process.h>
+
+namespace
+{
+
+//! The number of producer threads.
+const int NUM_THREADS = 4;
+
+//! The number of items added by each producer.
+const int NUM_ITEMS = 20000;
+
+//! The array shared by the producers.
+TConcurrentArray<int>* s_pArray = NULL;
+
+//! A producer which adds its items both singly and in batches.
+unsigned __stdcall Producer(void* pParam)
+{
+	int         nThread = static_cast<int>(reinterpret_cast<INT_PTR>(pParam));
+	TArray<int> vBatch;
+
+	for (int i = 0; i != NUM_ITEMS; ++i)
+	{
+		int nValue = (nThread * NUM_ITEMS) + i;
+
+		if ((i % 3) == 0)
+		{
+			vBatch.Add(nValue);
+
+			if (vBatch.Size() == 37)
+			{
+				s_pArray->AddRange(vBatch);
+				vBatch.RemoveAll();
+			}
+		}
+		else
+		{
+			s_pArray->Add(nValue);
+		}
+	}
+
+	s_pArray->AddRange(vBatch);
+
+	return 0;
+}
+
+//! Check the array holds each value in the range exactly once.
+bool HasEachValueOnce(const TArray<int>& vArray, size_t nFirst, int nCount)
+{
+	TArray<int> vSeen;
+
+	for (int i = 0; i != nCount; ++i)
+		vSeen.Add(0);
+
+	for (size_t i = nFirst; i != vArray.Size(); ++i)
+	{
+		int nValue = vArray[i];
+
+		if ( (nValue < 0) || (nValue >= nCount) || (vSeen[nValue] != 0) )
+			return false;
+
+		vSeen.Set(nValue, 1);
+	}
+
+	return (vArray.Size() - nFirst) == static_cast<size_t>(nCount);
+}
+
+}
+
+TEST_SET(ConcurrentArray)
+{
+
+TEST_CASE("An empty concurrent array seals to an empty array")
+{
+	TConcurrentArray<int> vArray;
+	TArray<int>           vSealed;
+
+	TEST_TRUE(vArray.Size() == 0);
+
+	vArray.AddRange(NULL, 0);
+	vArray.Seal(vSealed);
+
+	TEST_TRUE(vArray.Size() == 0);
+	TEST_TRUE(vSealed.Size() == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("Ranges that span several segments are added in order")
+{
+	TConcurrentArray<int> vArray;
+	TArray<int>           vRange;
+
+	for (int i = 0; i != 5000; ++i)
+		vRange.Add(i);
+
+	vArray.Add(-1);
+
+	TEST_TRUE(vArray.AddRange(vRange) == 1);
+	TEST_TRUE(vArray.Size() == 5001);
+	TEST_TRUE(vArray[0] == -1);
+
+	bool bInOrder = true;
+
+	for (int i = 0; i != 5000; ++i)
+		bInOrder = bInOrder && (vArray.At(i+1) == i);
+
+	TEST_TRUE(bInOrder);
+}
+TEST_CASE_END
+
+TEST_CASE("Sealing appends the items to the array and empties the concurrent array")
+{
+	TConcurrentArray<int> vArray;
+	TArray<int>           vSealed;
+
+	for (int i = 0; i != 3000; ++i)
+		vArray.Add(i);
+
+	vSealed.Add(-1);
+	vArray.Seal(vSealed);
+
+	TEST_TRUE(vArray.Size() == 0);
+	TEST_TRUE(vSealed.Size() == 3001);
+	TEST_TRUE((vSealed[0] == -1) && (vSealed[1] == 0) && (vSealed[3000] == 2999));
+
+	vArray.Add(7);
+
+	TEST_TRUE((vArray.Size() == 1) && (vArray[0] == 7));
+}
+TEST_CASE_END
+
+TEST_CASE("Items added by several threads at once are each stored once")
+{
+	TConcurrentArray<int> vArray;
+	HANDLE                ahThreads[NUM_THREADS];
+
+	s_pArray = &vArray;
+
+	for (int t = 0; t != NUM_THREADS; ++t)
+		ahThreads[t] = reinterpret_cast<HANDLE>(_beginthreadex(NULL, 0, Producer, reinterpret_cast<void*>(static_cast<INT_PTR>(t)), 0, NULL));
+
+	for (int t = 0; t != NUM_THREADS; ++t)
+	{
+		::WaitForSingleObject(ahThreads[t], INFINITE);
+		::CloseHandle(ahThreads[t]);
+	}
+
+	s_pArray = NULL;
+
+	TEST_TRUE(vArray.Size() == (NUM_THREADS * NUM_ITEMS));
+
+	TArray<int> vSealed;
+
+	vArray.Seal(vSealed);
+
+	TEST_TRUE(HasEachValueOnce(vSealed, 0, NUM_THREADS * NUM_ITEMS));
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   GapArrayTests.cpp
+//! \brief  The unit tests for the TGapArray class.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TGapArray.hpp>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+//! Make the string for a value.
+std::string MakeString(int nValue)
+{
+	return std::string(20 + (nValue % 7), static_cast<char>('a' + (nValue % 26)));
+}
+
+//! Check the array holds the same items as the reference.
+template<class T>
+bool Matches(TGapArray<T>& vArray, const std::vector<T>& vExpected)
+{
+	if (vArray.Size() != vExpected.size())
+		return false;
+
+	for (size_t i = 0; i != vExpected.size(); ++i)
+	{
+		if (vArray[i] != vExpected[i])
+			return false;
+	}
+
+	const T* pItems = vArray.Compact();
+
+	for (size_t i = 0; i != vExpected.size(); ++i)
+	{
+		if (pItems[i] != vExpected[i])
+			return false;
+	}
+
+	return true;
+}
+
+//! Apply the same edits, at a cursor that jumps back and forth, to the array
+//! and a reference vector.
+template<class T, class F>
+bool MatchesVector(F pfnMake)
+{
+	TGapArray<T>   vArray;
+	std::vector<T> vExpected;
+	size_t         nCursor = 0;
+	uint           nSeed   = 12345;
+
+	for (int i = 0; i != 2000; ++i)
+	{
+		nSeed = (nSeed * 1103515245) + 12345;
+
+		uint nRand = nSeed >> 16;
+
+		// Jump to another position?
+		if ((nRand % 16) == 0)
+			nCursor = (nRand / 16) % (vExpected.size() + 1);
+
+		switch (nRand % 5)
+		{
+			case 0:
+			case 1:
+			{
+				T Item = pfnMake(i);
+
+				vArray.Insert(nCursor, Item);
+				vExpected.insert(vExpected.begin() + nCursor, Item);
+				++nCursor;
+			}
+			break;
+
+			case 2:
+			{
+				T Item = pfnMake(i);
+
+				vArray.Add(Item);
+				vExpected.push_back(Item);
+			}
+			break;
+
+			case 3:
+			{
+				if (nCursor < vExpected.size())
+				{
+					vArray.Remove(nCursor);
+					vExpected.erase(vExpected.begin() + nCursor);
+				}
+			}
+			break;
+
+			default:
+			{
+				size_t nCount = std::min<size_t>(3, vExpected.size() - nCursor);
+
+				vArray.RemoveRange(nCursor, nCount);
+				vExpected.erase(vExpected.begin() + nCursor, vExpected.begin() + nCursor + nCount);
+			}
+			break;
+		}
+
+		if ( ((i % 101) == 0) && (!Matches(vArray, vExpected)) )
+			return false;
+	}
+
+	return Matches(vArray, vExpected);
+}
+
+//! Make the int for a value.
+int MakeInt(int nValue)
+{
+	return nValue;
+}
+
+}
+
+TEST_SET(GapArray)
+{
+
+TEST_CASE("An empty gap array has no items")
+{
+	TGapArray<int> vArray;
+
+	vArray.Compact();
+	vArray.RemoveRange(0, 0);
+
+	TEST_TRUE(vArray.Size() == 0);
+	TEST_TRUE(vArray.Find(0) == Core::npos);
+}
+TEST_CASE_END
+
+TEST_CASE("Inserting either side of the gap keeps the items in order")
+{
+	TGapArray<int> vArray;
+
+	for (int i = 0; i != 10; ++i)
+		vArray.Add(i * 10);
+
+	vArray.Insert(5, 45);
+	vArray.Insert(2, 15);
+	vArray.Insert(9, 75);
+	vArray.Insert(0, -10);
+
+	const int aExpected[] = { -10, 0, 10, 15, 20, 30, 40, 45, 50, 60, 75, 70, 80, 90 };
+
+	TEST_TRUE(vArray.Size() == 14);
+
+	for (size_t i = 0; i != 14; ++i)
+		TEST_TRUE(vArray[i] == aExpected[i]);
+
+	TEST_TRUE(vArray.Find(75) == 10);
+}
+TEST_CASE_END
+
+TEST_CASE("Removing a range either side of the gap closes it")
+{
+	TGapArray<int> vArray;
+
+	for (int i = 0; i != 20; ++i)
+		vArray.Add(i);
+
+	vArray.Insert(10, 100);
+	vArray.RemoveRange(2, 3);
+	vArray.RemoveRange(10, 5);
+
+	const int aExpected[] = { 0, 1, 5, 6, 7, 8, 9, 100, 10, 11, 17, 18, 19 };
+
+	TEST_TRUE(vArray.Size() == 13);
+
+	for (size_t i = 0; i != 13; ++i)
+		TEST_TRUE(vArray[i] == aExpected[i]);
+
+	vArray.RemoveAll();
+
+	TEST_TRUE(vArray.Size() == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("Random edits around a moving cursor match a vector")
+{
+	TEST_TRUE(MatchesVector<int>(MakeInt));
+	TEST_TRUE(MatchesVector<std::string>(MakeString));
+}
+TEST_CASE_END
+
+TEST_CASE("Adding and inserting ranges either side of the gap keeps the items in order")
+{
+	TGapArray<int> vArray;
+	TArray<int>    vItems;
+
+	for (int i = 0; i != 3; ++i)
+		vItems.Add(100 + i);
+
+	const int anItems[] = { 0, 10, 20, 30 };
+
+	TEST_TRUE(vArray.AddRange(anItems, 4) == 0);
+	TEST_TRUE(vArray.AddRange(vItems) == 4);
+
+	vArray.InsertRange(2, anItems, anItems + 2);
+	vArray.InsertRange(1, vItems);
+	vArray.InsertRange(10, anItems + 3, anItems + 4);
+	vArray.InsertRange(0, anItems, anItems);
+	TEST_TRUE(vArray.AddRange(anItems, 0) == 13);
+
+	const int aExpected[] = { 0, 100, 101, 102, 10, 0, 10, 20, 30, 100, 30, 101 };
+
+	TEST_TRUE(vArray.Size() == 13);
+
+	for (size_t i = 0; i != 12; ++i)
+		TEST_TRUE(vArray[i] == aExpected[i]);
+
+	TEST_TRUE(vArray[12] == 102);
+}
+TEST_CASE_END
+
+TEST_CASE("Inserting the array's own items copies them first")
+{
+	TGapArray<std::string> vArray;
+
+	for (int i = 0; i != 4; ++i)
+		vArray.Add(MakeString(i));
+
+	vArray.Insert(2, MakeString(9));
+
+	const std::string* pItems = vArray.Compact();
+
+	vArray.InsertRange(1, pItems, pItems + 5);
+
+	const int aExpected[] = { 0, 0, 1, 9, 2, 3, 1, 9, 2, 3 };
+
+	TEST_TRUE(vArray.Size() == 10);
+
+	for (size_t i = 0; i != 10; ++i)
+		TEST_TRUE(vArray[i] == MakeString(aExpected[i]));
+}
+TEST_CASE_END
+
+TEST_CASE("The items can be iterated after compacting the array")
+{
+	TGapArray<int> vArray;
+
+	vArray.Compact();
+
+	TEST_TRUE(vArray.begin() == vArray.end());
+
+	for (int i = 0; i != 10; ++i)
+		vArray.Insert(0, i);
+
+	vArray.Remove(5);
+	vArray.Compact();
+
+	TEST_TRUE(static_cast<size_t>(vArray.end() - vArray.begin()) == vArray.size());
+
+	int nExpected = 9;
+
+	for (TGapArray<int>::const_iterator it = vArray.begin(); it != vArray.end(); ++it, --nExpected)
+	{
+		if (nExpected == 4)
+			--nExpected;
+
+		TEST_TRUE(*it == nExpected);
+	}
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
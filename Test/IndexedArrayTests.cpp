@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   IndexedArrayTests.cpp
+//! \brief  The unit tests for the TIndexedArray class.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TIndexedArray.hpp>
+
+namespace
+{
+
+typedef TIndexedArray<int> CIntArray;
+
+//! A hash which uses the value, so that the tests control the collisions.
+struct ValueHash
+{
+	size_t operator()(const int& nValue) const
+	{
+		return static_cast<size_t>(nValue);
+	}
+};
+
+typedef TIndexedArray<int, ValueHash> CValueArray;
+
+//! Find an item with a linear search.
+template<class A>
+size_t LinearFind(const A& vArray, int nValue)
+{
+	for (size_t i = 0; i != vArray.Size(); ++i)
+	{
+		if (vArray[i] == nValue)
+			return i;
+	}
+
+	return Core::npos;
+}
+
+//! Query if Find() agrees with a linear search for all the values in a range.
+template<class A>
+bool FindAgrees(const A& vArray, int nMax)
+{
+	for (int i = -1; i <= nMax; ++i)
+	{
+		if (vArray.Find(i) != LinearFind(vArray, i))
+			return false;
+	}
+
+	return true;
+}
+
+}
+
+TEST_SET(IndexedArray)
+{
+
+TEST_CASE("An empty array finds nothing")
+{
+	CIntArray vArray;
+
+	TEST_TRUE(vArray.Size() == 0);
+	TEST_TRUE(vArray.Find(0) == Core::npos);
+	TEST_FALSE(vArray.Contains(0));
+
+	vArray.Reindex();
+
+	TEST_TRUE(vArray.Find(0) == Core::npos);
+}
+TEST_CASE_END
+
+TEST_CASE("Added items are found at their position as the index grows")
+{
+	CIntArray vArray;
+
+	for (int i = 0; i != 1000; ++i)
+		TEST_TRUE(vArray.Add(i * 3) == static_cast<size_t>(i));
+
+	TEST_TRUE(vArray.Find(0) == 0);
+	TEST_TRUE(vArray.Find(2997) == 999);
+	TEST_TRUE(vArray.Find(1) == Core::npos);
+	TEST_TRUE(FindAgrees(vArray, 3000));
+}
+TEST_CASE_END
+
+TEST_CASE("Finding a duplicate returns the first position")
+{
+	CIntArray vArray;
+
+	vArray.Add(7);
+	vArray.Add(5);
+	vArray.Add(7);
+	vArray.Add(5);
+
+	TEST_TRUE(vArray.Find(7) == 0);
+	TEST_TRUE(vArray.Find(5) == 1);
+
+	vArray.Set(0, 1);
+
+	TEST_TRUE(vArray.Find(7) == 2);
+
+	vArray.Remove(3);
+	vArray.Remove(2);
+
+	TEST_TRUE(vArray.Find(7) == Core::npos);
+	TEST_TRUE(vArray.Find(5) == 1);
+}
+TEST_CASE_END
+
+TEST_CASE("Unindexing an item shifts the following items of a probe sequence back")
+{
+	CValueArray vArray;
+
+	// All but the last share the last slot and so wrap around to the start.
+	vArray.Add(15);
+	vArray.Add(31);
+	vArray.Add(47);
+	vArray.Add(0);
+
+	TEST_TRUE(FindAgrees(vArray, 64));
+
+	vArray.Set(0, 2);
+
+	TEST_TRUE(vArray.Find(31) == 1);
+	TEST_TRUE(vArray.Find(47) == 2);
+	TEST_TRUE(vArray.Find(0) == 3);
+	TEST_TRUE(vArray.Find(15) == Core::npos);
+	TEST_TRUE(FindAgrees(vArray, 64));
+
+	vArray.Set(1, 63);
+	vArray.Remove(3);
+
+	TEST_TRUE(vArray.Find(0) == Core::npos);
+	TEST_TRUE(FindAgrees(vArray, 64));
+}
+TEST_CASE_END
+
+TEST_CASE("Inserting or removing in the middle reindexes on the next search")
+{
+	CIntArray vArray;
+
+	for (int i = 0; i != 100; ++i)
+		vArray.Add(i);
+
+	vArray.Insert(0, 100);
+	vArray.Insert(50, 101);
+	vArray.Remove(10);
+	vArray.RemoveRange(20, 5);
+
+	TEST_TRUE(vArray.Find(100) == 0);
+	TEST_TRUE(vArray.Find(101) == 44);
+	TEST_TRUE(vArray.Find(9) == Core::npos);
+	TEST_TRUE(FindAgrees(vArray, 102));
+
+	vArray.Insert(1, 102);
+	vArray.Add(103);
+	vArray.Set(2, 104);
+
+	TEST_TRUE(vArray.Find(103) == (vArray.Size() - 1));
+	TEST_TRUE(vArray.Find(104) == 2);
+	TEST_TRUE(FindAgrees(vArray, 105));
+}
+TEST_CASE_END
+
+TEST_CASE("Adding a range indexes the new items")
+{
+	CIntArray vArray;
+	TArray<int> vItems;
+
+	for (int i = 0; i != 100; ++i)
+		vItems.Add(i % 10);
+
+	vArray.Add(5);
+
+	TEST_TRUE(vArray.AddRange(vItems) == 1);
+	TEST_TRUE(vArray.AddRange(vItems.begin(), 0) == 101);
+	TEST_TRUE(vArray.Find(5) == 0);
+	TEST_TRUE(vArray.Find(9) == 10);
+	TEST_TRUE(FindAgrees(vArray, 10));
+}
+TEST_CASE_END
+
+TEST_CASE("Find agrees with a linear search after a mixture of edits")
+{
+	CValueArray vArray;
+	unsigned    nSeed = 12345;
+
+	for (int n = 0; n != 2000; ++n)
+	{
+		nSeed = (nSeed * 1103515245u) + 12345u;
+
+		int    nValue = static_cast<int>((nSeed >> 8) % 64);
+		size_t nSize  = vArray.Size();
+
+		switch ((nSeed >> 20) % 5)
+		{
+			case 2:	if (nSize != 0) vArray.Set(nValue % nSize, nValue * 2);		break;
+			case 3:	if (nSize != 0) vArray.Remove(nSize - 1);					break;
+			case 4:	vArray.Insert((nSize != 0) ? (nValue % nSize) : 0, nValue);	break;
+			default:	vArray.Add(nValue);										break;
+		}
+
+		if ((n % 50) == 0)
+			TEST_TRUE(FindAgrees(vArray, 128));
+	}
+
+	TEST_TRUE(FindAgrees(vArray, 128));
+
+	vArray.RemoveAll();
+
+	TEST_TRUE(vArray.Find(0) == Core::npos);
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
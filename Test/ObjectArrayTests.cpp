@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   ObjectArrayTests.cpp
+//! \brief  The unit tests for TArray with items that are not trivially copyable.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TArray.hpp>
+#include <string>
+
+namespace
+{
+
+//! An item which counts the live instances.
+struct Item
+{
+	Item()
+		: m_nValue(0)
+	{
+		++s_nLive;
+	}
+
+	Item(int nValue)
+		: m_nValue(nValue)
+	{
+		++s_nLive;
+	}
+
+	Item(const Item& oItem)
+		: m_nValue(oItem.m_nValue)
+	{
+		++s_nLive;
+	}
+
+	~Item()
+	{
+		--s_nLive;
+	}
+
+	Item& operator=(const Item& oItem)
+	{
+		m_nValue = oItem.m_nValue;
+		return *this;
+	}
+
+	bool operator==(const Item& oItem) const
+	{
+		return (m_nValue == oItem.m_nValue);
+	}
+
+	int			m_nValue;
+	static int	s_nLive;
+};
+
+int Item::s_nLive = 0;
+
+//! The predicate for items with an odd value.
+bool IsOdd(const Item& oItem)
+{
+	return ((oItem.m_nValue % 2) != 0);
+}
+
+}
+
+TEST_SET(ObjectArray)
+{
+
+TEST_CASE("The type traits detect which types can be copied bytewise")
+{
+	TEST_TRUE(TIsTrivial<int>::VALUE);
+	TEST_TRUE(TIsTrivial<int*>::VALUE);
+	TEST_FALSE(TIsTrivial<std::string>::VALUE);
+}
+TEST_CASE_END
+
+TEST_CASE("Strings survive the buffer growing, inserts and removes")
+{
+	TArray<std::string> vArray;
+
+	for (int i = 0; i != 100; ++i)
+		vArray.Add(std::string(50, static_cast<char>('a' + (i % 26))));
+
+	vArray.Insert(0, "front");
+	vArray.Insert(50, "middle");
+
+	TEST_TRUE(vArray.Size() == 102);
+	TEST_TRUE((vArray[0] == "front") && (vArray[50] == "middle"));
+	TEST_TRUE(vArray[1] == std::string(50, 'a'));
+	TEST_TRUE(vArray[101] == std::string(50, 'v'));
+
+	vArray.Remove(50);
+	vArray.Remove(0);
+	vArray.RemoveRange(10, 80);
+
+	TEST_TRUE(vArray.Size() == 20);
+	TEST_TRUE(vArray[10] == std::string(50, 'm'));
+}
+TEST_CASE_END
+
+TEST_CASE("Inserting the array's own strings copies them before they move")
+{
+	TArray<std::string> vArray;
+
+	vArray.Add("a");
+	vArray.Add("b");
+	vArray.Add("c");
+	vArray.ShrinkToFit();
+
+	vArray.InsertRange(1, vArray.begin(), vArray.end());
+
+	const char* apszExpected[] = { "a", "a", "b", "c", "b", "c" };
+
+	TEST_TRUE(vArray.Size() == 6);
+
+	for (size_t i = 0; i != 6; ++i)
+		TEST_TRUE(vArray[i] == apszExpected[i]);
+}
+TEST_CASE_END
+
+TEST_CASE("Every item constructed is destroyed exactly once")
+{
+	{
+		TArray<Item> vArray;
+
+		for (int i = 0; i != 50; ++i)
+			vArray.Add(Item(i));
+
+		TEST_TRUE(Item::s_nLive == 50);
+		TEST_TRUE(vArray.RemoveIf(IsOdd) == 25);
+		TEST_TRUE(Item::s_nLive == 25);
+
+		vArray.Emplace(7);
+		vArray.Emplace();
+
+		TEST_TRUE(Item::s_nLive == 27);
+		TEST_TRUE(vArray[25].m_nValue == 7);
+
+		vArray.RemoveRange(1, 26);
+		vArray.ShrinkToFit();
+
+		TEST_TRUE(Item::s_nLive == 1);
+		TEST_TRUE(vArray.Find(Item(0)) == 0);
+
+		for (int i = 0; i != 10; ++i)
+			vArray.Insert(0, Item(i));
+
+		TEST_TRUE(Item::s_nLive == 11);
+	}
+
+	TEST_TRUE(Item::s_nLive == 0);
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
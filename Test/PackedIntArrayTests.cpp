@@ -0,0 +1,176 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   PackedIntArrayTests.cpp
+//! \brief  The unit tests for the CBitPacking and TPackedIntArray classes.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TPackedIntArray.hpp>
+#include <limits.h>
+
+namespace
+{
+
+//! Generate a pseudo-random number.
+uint NextRandom(uint& nSeed)
+{
+	nSeed = (nSeed * 1103515245) + 12345;
+
+	return (nSeed >> 8) ^ (nSeed << 13);
+}
+
+//! Check a packed block unpacks to the original values with both the
+//! block decoder and the single item extractor.
+bool RoundTrips(uint nWidth, uint nMin)
+{
+	uint aDeltas[CBitPacking::BLOCK_SIZE];
+	uint aWords[CBitPacking::NUM_LANES * 32];
+	uint aValues[CBitPacking::BLOCK_SIZE];
+	uint nMask = (nWidth == 32) ? UINT_MAX : ((1u << nWidth) - 1);
+	uint nSeed = nWidth;
+
+	for (size_t i = 0; i != CBitPacking::BLOCK_SIZE; ++i)
+		aDeltas[i] = NextRandom(nSeed) & nMask;
+
+	// Include the extremes.
+	aDeltas[0] = 0;
+	aDeltas[CBitPacking::BLOCK_SIZE-1] = nMask;
+
+	CBitPacking::Pack(aDeltas, nWidth, aWords);
+	CBitPacking::Unpack(aWords, nWidth, nMin, aValues);
+
+	for (size_t i = 0; i != CBitPacking::BLOCK_SIZE; ++i)
+	{
+		if (aValues[i] != (nMin + aDeltas[i]))
+			return false;
+
+		if (CBitPacking::Extract(aWords, nWidth, i) != aDeltas[i])
+			return false;
+	}
+
+	return true;
+}
+
+//! Check the array holds the same values as the reference.
+template<class T>
+bool Matches(const TPackedIntArray<T>& vArray, const TArray<T>& vExpected)
+{
+	if (vArray.Size() != vExpected.Size())
+		return false;
+
+	for (size_t i = 0; i != vExpected.Size(); ++i)
+	{
+		if (vArray[i] != vExpected[i])
+			return false;
+	}
+
+	TArray<T> vDecoded;
+
+	vArray.Decode(vDecoded);
+
+	if (vDecoded.Size() != vExpected.Size())
+		return false;
+
+	for (size_t i = 0; i != vExpected.Size(); ++i)
+	{
+		if (vDecoded[i] != vExpected[i])
+			return false;
+	}
+
+	return true;
+}
+
+}
+
+TEST_SET(PackedIntArray)
+{
+
+TEST_CASE("The width is the number of bits needed for the largest delta")
+{
+	TEST_TRUE(CBitPacking::Width(0) == 0);
+	TEST_TRUE(CBitPacking::Width(1) == 1);
+	TEST_TRUE(CBitPacking::Width(255) == 8);
+	TEST_TRUE(CBitPacking::Width(256) == 9);
+	TEST_TRUE(CBitPacking::Width(UINT_MAX) == 32);
+}
+TEST_CASE_END
+
+TEST_CASE("The SIMD block decoder and the scalar extractor agree for every width")
+{
+	for (uint nWidth = 0; nWidth <= 32; ++nWidth)
+	{
+		TEST_TRUE(RoundTrips(nWidth, 0));
+		TEST_TRUE(RoundTrips(nWidth, 1000));
+	}
+}
+TEST_CASE_END
+
+TEST_CASE("An empty packed array has no items")
+{
+	TPackedIntArray<int> vArray;
+	TArray<int>          vDecoded;
+
+	vArray.Decode(vDecoded);
+
+	TEST_TRUE(vArray.Size() == 0);
+	TEST_TRUE(vDecoded.Size() == 0);
+	TEST_TRUE(vArray.PackedSize() == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("Items in full blocks and the unpacked tail read back the same")
+{
+	TPackedIntArray<int> vArray;
+	TArray<int>          vExpected;
+
+	for (int i = 0; i != 1000; ++i)
+	{
+		int nValue = 5000 + ((i * 37) % 300);
+
+		vExpected.Add(nValue);
+		TEST_TRUE(vArray.Add(nValue) == static_cast<size_t>(i));
+	}
+
+	TEST_TRUE(Matches(vArray, vExpected));
+	TEST_TRUE(vArray.PackedSize() < (vExpected.Size() * sizeof(int)));
+}
+TEST_CASE_END
+
+TEST_CASE("Negative and extreme values are packed across the full range")
+{
+	TPackedIntArray<int> vArray;
+	TArray<int>          vExpected;
+	uint                 nSeed = 1;
+
+	for (size_t i = 0; i != (CBitPacking::BLOCK_SIZE * 3) + 5; ++i)
+		vExpected.Add(static_cast<int>(NextRandom(nSeed) >> 1) - (INT_MAX / 2));
+
+	vExpected.Set(1, INT_MIN);
+	vExpected.Set(2, INT_MAX);
+	vExpected.Set(CBitPacking::BLOCK_SIZE + 1, -1);
+
+	vArray.AddRange(vExpected);
+
+	TEST_TRUE(Matches(vArray, vExpected));
+}
+TEST_CASE_END
+
+TEST_CASE("Blocks of equal values are packed into no bits")
+{
+	TPackedIntArray<uint> vArray;
+	TArray<uint>          vExpected;
+
+	for (size_t i = 0; i != CBitPacking::BLOCK_SIZE * 2; ++i)
+		vExpected.Add(UINT_MAX);
+
+	vArray.AddRange(vExpected.begin(), vExpected.Size());
+
+	TEST_TRUE(Matches(vArray, vExpected));
+
+	vArray.RemoveAll();
+
+	TEST_TRUE(vArray.Size() == 0);
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
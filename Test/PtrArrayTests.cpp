@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   PtrArrayTests.cpp
+//! \brief  The unit tests for the TPtrArray class.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TArray.hpp>
+
+namespace
+{
+
+//! An item which counts the live instances.
+struct Item
+{
+	Item(int nValue)
+		: m_nValue(nValue)
+	{
+		++s_nLive;
+	}
+
+	Item(const Item& oItem)
+		: m_nValue(oItem.m_nValue)
+	{
+		++s_nLive;
+	}
+
+	~Item()
+	{
+		--s_nLive;
+	}
+
+	int			m_nValue;
+	static int	s_nLive;
+};
+
+int Item::s_nLive = 0;
+
+//! The predicate for items greater than a value.
+struct IsGreater
+{
+	IsGreater(int nValue)
+		: m_nValue(nValue)
+	{
+	}
+
+	bool operator()(const Item* pItem) const
+	{
+		return (pItem->m_nValue > m_nValue);
+	}
+
+	int m_nValue;
+};
+
+//! Fill an array with heap items holding the values 0..N-1.
+void FillArray(TPtrArray<Item>& vArray, int nCount)
+{
+	for (int i = 0; i != nCount; ++i)
+		vArray.Add(new Item(i));
+}
+
+}
+
+TEST_SET(PtrArray)
+{
+
+TEST_CASE("Deleting items that match a predicate destroys only those items")
+{
+	{
+		TPtrArray<Item> vArray;
+
+		TEST_TRUE(vArray.DeleteIf(IsGreater(0)) == 0);
+
+		for (int i = 0; i != 10; ++i)
+			vArray.Add(new Item(i));
+
+		TEST_TRUE(vArray.DeleteIf(IsGreater(5)) == 4);
+		TEST_TRUE(vArray.Size() == 6);
+		TEST_TRUE(Item::s_nLive == 6);
+
+		for (int i = 0; i != 6; ++i)
+			TEST_TRUE(vArray[i]->m_nValue == i);
+
+		vArray.DeleteAll();
+	}
+
+	TEST_TRUE(Item::s_nLive == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("Deleting a range destroys the items and closes the gap")
+{
+	TPtrArray<Item> vArray;
+
+	for (int i = 0; i != 10; ++i)
+		vArray.Add(new Item(i));
+
+	vArray.DeleteRange(0, 2);
+
+	TEST_TRUE(vArray.Size() == 8);
+	TEST_TRUE(Item::s_nLive == 8);
+	TEST_TRUE(vArray[0]->m_nValue == 2);
+
+	vArray.DeleteRange(8, 0);
+
+	TEST_TRUE(Item::s_nLive == 8);
+
+	vArray.DeleteAll();
+
+	TEST_TRUE(vArray.Size() == 0);
+	TEST_TRUE(Item::s_nLive == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("Deep copying into a slab copies the items and destroys them with the array")
+{
+	TPtrArray<Item> vSource;
+
+	FillArray(vSource, 10);
+
+	{
+		TPtrArray<Item> vArray;
+
+		vArray.DeepCopy(vSource, TPtrArray<Item>::COPY_SLAB);
+
+		TEST_TRUE(vArray.Size() == 10);
+		TEST_TRUE(Item::s_nLive == 20);
+
+		for (int i = 0; i != 10; ++i)
+		{
+			TEST_TRUE(vArray[i] != vSource[i]);
+			TEST_TRUE(vArray[i]->m_nValue == i);
+		}
+
+		TEST_TRUE(vArray[9] == (vArray[0] + 9));
+	}
+
+	TEST_TRUE(Item::s_nLive == 10);
+
+	vSource.DeleteAll();
+
+	TEST_TRUE(Item::s_nLive == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("Deep copying an empty array into a slab does nothing")
+{
+	TPtrArray<Item> vSource;
+	TPtrArray<Item> vArray;
+
+	vArray.DeepCopy(vSource, TPtrArray<Item>::COPY_SLAB);
+
+	TEST_TRUE(vArray.Size() == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("Removing slab items destroys them but not the heap items")
+{
+	TPtrArray<Item> vSource;
+
+	FillArray(vSource, 10);
+
+	{
+		TPtrArray<Item> vArray;
+
+		vArray.DeepCopy(vSource, TPtrArray<Item>::COPY_SLAB);
+		vArray.DeepCopy(vSource, TPtrArray<Item>::COPY_SLAB);
+		vArray.ShallowCopy(vSource);
+
+		TEST_TRUE(vArray.Size() == 30);
+		TEST_TRUE(Item::s_nLive == 30);
+
+		vArray.Remove(0);
+
+		TEST_TRUE(Item::s_nLive == 29);
+
+		vArray.RemoveRange(8, 3);
+
+		TEST_TRUE(Item::s_nLive == 26);
+
+		vArray.RemoveIf(IsGreater(7));
+
+		TEST_TRUE(vArray.Size() == 21);
+		TEST_TRUE(Item::s_nLive == 23);
+
+		vArray.RemoveRange(vArray.Size() - 5, 5);
+
+		TEST_TRUE(Item::s_nLive == 23);
+
+		vArray.RemoveAll();
+
+		TEST_TRUE(vArray.Size() == 0);
+		TEST_TRUE(Item::s_nLive == 10);
+	}
+
+	TEST_TRUE(Item::s_nLive == 10);
+
+	vSource.DeleteAll();
+}
+TEST_CASE_END
+
+TEST_CASE("Replacing a slab item destroys it")
+{
+	TPtrArray<Item> vSource;
+
+	FillArray(vSource, 3);
+
+	{
+		TPtrArray<Item> vArray;
+
+		vArray.DeepCopy(vSource, TPtrArray<Item>::COPY_SLAB);
+
+		Item* pItem = vArray[1];
+
+		vArray.Set(1, pItem);
+
+		TEST_TRUE(Item::s_nLive == 6);
+
+		vArray.Set(1, vSource[1]);
+
+		TEST_TRUE(Item::s_nLive == 5);
+		TEST_TRUE(vArray[1] == vSource[1]);
+	}
+
+	TEST_TRUE(Item::s_nLive == 3);
+
+	vSource.DeleteAll();
+}
+TEST_CASE_END
+
+TEST_CASE("Deleting a mixture of heap and slab items destroys each correctly")
+{
+	TPtrArray<Item> vSource;
+
+	FillArray(vSource, 10);
+
+	{
+		TPtrArray<Item> vArray;
+
+		vArray.DeepCopy(vSource, TPtrArray<Item>::COPY_SLAB);
+		vArray.DeepCopy(vSource, TPtrArray<Item>::COPY_HEAP);
+		vArray.DeepCopy(vSource, TPtrArray<Item>::COPY_SLAB);
+
+		TEST_TRUE(Item::s_nLive == 40);
+
+		TEST_TRUE(vArray.DeleteIf(IsGreater(4)) == 15);
+		TEST_TRUE(vArray.Size() == 15);
+		TEST_TRUE(Item::s_nLive == 25);
+
+		for (size_t i = 0; i != vArray.Size(); ++i)
+			TEST_TRUE(vArray[i]->m_nValue == static_cast<int>(i % 5));
+
+		vArray.Delete(0);
+		vArray.DeleteRange(4, 6);
+
+		TEST_TRUE(Item::s_nLive == 18);
+
+		vArray.DeleteAll();
+
+		TEST_TRUE(Item::s_nLive == 10);
+	}
+
+	TEST_TRUE(Item::s_nLive == 10);
+
+	vSource.DeleteAll();
+
+	TEST_TRUE(Item::s_nLive == 0);
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
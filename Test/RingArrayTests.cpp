@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   RingArrayTests.cpp
+//! \brief  The unit tests for the TRingArray class.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TRingArray.hpp>
+#include <string>
+
+namespace
+{
+
+//! Check the items, in order, across both spans.
+bool HasValues(const TRingArray<int>& vArray, int nFirst)
+{
+	size_t nCount1, nCount2;
+
+	const int* pSpan1 = vArray.FirstSpan(nCount1);
+	const int* pSpan2 = vArray.SecondSpan(nCount2);
+
+	if ((nCount1 + nCount2) != vArray.Size())
+		return false;
+
+	for (size_t i = 0; i != nCount1; ++i)
+	{
+		if (pSpan1[i] != (nFirst + static_cast<int>(i)))
+			return false;
+	}
+
+	for (size_t i = 0; i != nCount2; ++i)
+	{
+		if (pSpan2[i] != (nFirst + static_cast<int>(nCount1 + i)))
+			return false;
+	}
+
+	for (size_t i = 0; i != vArray.Size(); ++i)
+	{
+		if (vArray[i] != (nFirst + static_cast<int>(i)))
+			return false;
+	}
+
+	return true;
+}
+
+}
+
+TEST_SET(RingArray)
+{
+
+TEST_CASE("An empty ring has no items and empty spans")
+{
+	TRingArray<int> vArray;
+
+	size_t nCount1 = 1, nCount2 = 1;
+
+	vArray.FirstSpan(nCount1);
+	vArray.SecondSpan(nCount2);
+
+	TEST_TRUE(vArray.Empty());
+	TEST_TRUE(vArray.Size() == 0);
+	TEST_TRUE((nCount1 == 0) && (nCount2 == 0));
+}
+TEST_CASE_END
+
+TEST_CASE("Items added at the back are removed from the front in order")
+{
+	TRingArray<int> vArray;
+
+	for (int i = 0; i != 20; ++i)
+		vArray.PushBack(i);
+
+	TEST_TRUE((vArray.Front() == 0) && (vArray.Back() == 19));
+
+	for (int i = 0; i != 20; ++i)
+		TEST_TRUE(vArray.PopFront() == i);
+
+	TEST_TRUE(vArray.Empty());
+}
+TEST_CASE_END
+
+TEST_CASE("Items wrap around the end of the buffer into the second span")
+{
+	TRingArray<int> vArray;
+
+	for (int i = 0; i != 8; ++i)
+		vArray.PushBack(i);
+
+	size_t nCapacity = vArray.Capacity();
+
+	for (int i = 0; i != 5; ++i)
+		vArray.PopFront();
+
+	for (int i = 8; i != 12; ++i)
+		vArray.PushBack(i);
+
+	size_t nCount;
+
+	vArray.SecondSpan(nCount);
+
+	TEST_TRUE(vArray.Capacity() == nCapacity);
+	TEST_TRUE(nCount != 0);
+	TEST_TRUE(HasValues(vArray, 5));
+}
+TEST_CASE_END
+
+TEST_CASE("Growing a wrapped ring keeps the items in order")
+{
+	TRingArray<int> vArray;
+
+	for (int i = 0; i != 8; ++i)
+		vArray.PushBack(i);
+
+	for (int i = 0; i != 6; ++i)
+		vArray.PopFront();
+
+	for (int i = 8; i != 40; ++i)
+		vArray.PushBack(i);
+
+	TEST_TRUE(vArray.Size() == 34);
+	TEST_TRUE(HasValues(vArray, 6));
+}
+TEST_CASE_END
+
+TEST_CASE("Items added at the front wrap backwards around the buffer")
+{
+	TRingArray<int> vArray;
+
+	vArray.PushBack(10);
+
+	for (int i = 9; i != -10; --i)
+		vArray.PushFront(i);
+
+	TEST_TRUE(vArray.Size() == 20);
+	TEST_TRUE(HasValues(vArray, -9));
+	TEST_TRUE(vArray.PopBack() == 10);
+	TEST_TRUE(vArray.PopFront() == -9);
+}
+TEST_CASE_END
+
+TEST_CASE("Strings survive the ring wrapping and growing")
+{
+	TRingArray<std::string> vArray;
+
+	for (int i = 0; i != 6; ++i)
+		vArray.PushBack(std::string(20, static_cast<char>('a' + i)));
+
+	vArray.PopFront();
+	vArray.PopFront();
+
+	for (int i = 6; i != 20; ++i)
+		vArray.PushBack(std::string(20, static_cast<char>('a' + i)));
+
+	vArray.Set(0, "first");
+
+	TEST_TRUE(vArray.Size() == 18);
+	TEST_TRUE(vArray.Front() == "first");
+	TEST_TRUE(vArray[1] == std::string(20, 'd'));
+	TEST_TRUE(vArray.Back() == std::string(20, 't'));
+
+	vArray.RemoveAll();
+
+	TEST_TRUE(vArray.Empty());
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   SegmentedArrayTests.cpp
+//! \brief  The unit tests for the TSegmentedArray class.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TSegmentedArray.hpp>
+#include <string>
+
+TEST_SET(SegmentedArray)
+{
+
+TEST_CASE("An empty segmented array has no blocks")
+{
+	TSegmentedArray<int, 16> vArray;
+
+	TEST_TRUE(vArray.Size() == 0);
+	TEST_TRUE(vArray.Capacity() == 0);
+	TEST_TRUE(vArray.Find(0) == Core::npos);
+}
+TEST_CASE_END
+
+TEST_CASE("Items never move as the array grows")
+{
+	TSegmentedArray<int, 16> vArray;
+
+	vArray.Add(0);
+
+	const int* pFirst = vArray.Ptr(0);
+
+	for (int i = 1; i != 1000; ++i)
+		vArray.Add(i);
+
+	vArray.Reserve(5000);
+
+	TEST_TRUE(vArray.Ptr(0) == pFirst);
+	TEST_TRUE(vArray.Capacity() >= 5000);
+
+	for (int i = 0; i != 1000; ++i)
+		TEST_TRUE(vArray[i] == i);
+}
+TEST_CASE_END
+
+TEST_CASE("Find searches every block including the partial last one")
+{
+	TSegmentedArray<int, 16> vArray;
+
+	for (int i = 0; i != 100; ++i)
+		vArray.Add(i % 40);
+
+	TEST_TRUE(vArray.Find(0) == 0);
+	TEST_TRUE(vArray.Find(15) == 15);
+	TEST_TRUE(vArray.Find(16) == 16);
+	TEST_TRUE(vArray.Find(39) == 39);
+	TEST_TRUE(vArray.Find(40) == Core::npos);
+
+	vArray.Set(99, 1000);
+
+	TEST_TRUE(vArray.Find(1000) == 99);
+
+	vArray.RemoveLast();
+
+	TEST_TRUE(vArray.Find(1000) == Core::npos);
+}
+TEST_CASE_END
+
+TEST_CASE("Find ignores the unused slots of a reserved block")
+{
+	TSegmentedArray<int, 16> vArray;
+
+	vArray.Reserve(32);
+
+	for (int i = 0; i != 17; ++i)
+		vArray.Add(i);
+
+	vArray.RemoveLast();
+
+	TEST_TRUE(vArray.Find(16) == Core::npos);
+	TEST_TRUE(vArray.Find(15) == 15);
+}
+TEST_CASE_END
+
+TEST_CASE("Strings are found and destroyed across the blocks")
+{
+	TSegmentedArray<std::string, 8> vArray;
+
+	for (int i = 0; i != 50; ++i)
+		vArray.Add(std::string(20, static_cast<char>('a' + (i % 26))));
+
+	TEST_TRUE(vArray.Find(std::string(20, 'z')) == 25);
+	TEST_TRUE(vArray.Find("missing") == Core::npos);
+
+	vArray.RemoveAll();
+
+	TEST_TRUE((vArray.Size() == 0) && (vArray.Capacity() == 0));
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
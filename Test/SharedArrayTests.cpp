@@ -0,0 +1,224 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   SharedArrayTests.cpp
+//! \brief  The unit tests for the copy-on-write sharing of TArray buffers.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TSmallArray.hpp>
+#include <functional>
+#include <string>
+#include <process.h>
+
+namespace
+{
+
+//! Create an array holding the values 0..N-1.
+void FillArray(TArray<int>& vArray, int nCount)
+{
+	for (int i = 0; i != nCount; ++i)
+		vArray.Add(i);
+}
+
+//! Get the buffer without unsharing it.
+const int* Buffer(const TArray<int>& vArray)
+{
+	return vArray.begin();
+}
+
+//! The number of copying threads.
+const int NUM_THREADS = 4;
+
+//! The number of copies made by each thread.
+const int NUM_COPIES = 100;
+
+//! A thread which copies an array and checks its copies.
+unsigned __stdcall Copier(void* pParam)
+{
+	const TArray<int>& vArray = *static_cast<const TArray<int>*>(pParam);
+	unsigned           nErrors = 0;
+
+	for (int i = 0; i != NUM_COPIES; ++i)
+	{
+		TArray<int> vCopy(vArray);
+
+		if ( (Buffer(vCopy) != Buffer(vArray)) || (vCopy[9] != 9) )
+			++nErrors;
+	}
+
+	return nErrors;
+}
+
+}
+
+TEST_SET(SharedArray)
+{
+
+TEST_CASE("Copying an array shares the buffer until one of them is modified")
+{
+	TArray<int> vArray1;
+
+	FillArray(vArray1, 10);
+
+	TArray<int> vArray2(vArray1);
+
+	TEST_TRUE(Buffer(vArray1) == Buffer(vArray2));
+
+	vArray2.Add(10);
+
+	TEST_TRUE(Buffer(vArray1) != Buffer(vArray2));
+	TEST_TRUE((vArray1.Size() == 10) && (vArray2.Size() == 11));
+}
+TEST_CASE_END
+
+TEST_CASE("Copying an empty array shares nothing")
+{
+	TArray<int> vArray1;
+	TArray<int> vArray2(vArray1);
+
+	vArray2.Add(1);
+
+	TEST_TRUE(vArray1.Size() == 0);
+	TEST_TRUE(vArray2.Size() == 1);
+}
+TEST_CASE_END
+
+TEST_CASE("Each modifying method unshares the buffer before writing")
+{
+	TArray<int> vArray;
+
+	FillArray(vArray, 10);
+
+	TArray<int> vSet(vArray);
+	vSet.Set(0, 42);
+
+	TArray<int> vInsert(vArray);
+	vInsert.Insert(0, 7);
+
+	TArray<int> vRemove(vArray);
+	vRemove.Remove(0);
+
+	TArray<int> vRange(vArray);
+	vRange.RemoveRange(0, 5);
+
+	TArray<int> vSort(vArray);
+	vSort.Sort(std::greater<int>());
+
+	TArray<int> vIterator(vArray);
+	*vIterator.begin() = -1;
+
+	TEST_TRUE(vSet[0] == 42);
+	TEST_TRUE(vInsert[0] == 7);
+	TEST_TRUE(vRemove[0] == 1);
+	TEST_TRUE(vRange[0] == 5);
+	TEST_TRUE(vSort[0] == 9);
+	TEST_TRUE(vIterator[0] == -1);
+
+	TEST_TRUE(vArray.Size() == 10);
+
+	for (int i = 0; i != 10; ++i)
+		TEST_TRUE(vArray[i] == i);
+}
+TEST_CASE_END
+
+TEST_CASE("Removing all the items from a shared copy leaves the others intact")
+{
+	TArray<int> vArray1;
+
+	FillArray(vArray1, 10);
+
+	TArray<int> vArray2(vArray1);
+	TArray<int> vArray3(vArray2);
+
+	vArray2.RemoveAll();
+
+	TEST_TRUE(vArray2.Size() == 0);
+	TEST_TRUE((vArray1.Size() == 10) && (vArray3.Size() == 10));
+	TEST_TRUE(vArray3[9] == 9);
+}
+TEST_CASE_END
+
+TEST_CASE("Reserving or shrinking a shared copy unshares it")
+{
+	TArray<int> vArray1;
+
+	FillArray(vArray1, 10);
+
+	TArray<int> vArray2(vArray1);
+
+	vArray2.Reserve(1000);
+
+	TEST_TRUE(vArray2.Capacity() >= 1000);
+	TEST_TRUE(vArray1.Capacity() < 1000);
+	TEST_TRUE(vArray2[3] == 3);
+
+	TArray<int> vArray3(vArray1);
+
+	vArray3.ShrinkToFit();
+
+	TEST_TRUE(vArray3.Capacity() == 10);
+	TEST_TRUE((vArray1.Size() == 10) && (vArray3[9] == 9));
+}
+TEST_CASE_END
+
+TEST_CASE("Copies of inline and non-trivial arrays are deep copies")
+{
+	TSmallArray<int, 8> vSmall;
+
+	vSmall.Add(1);
+	vSmall.Add(2);
+
+	TArray<int> vCopy(vSmall);
+
+	TEST_TRUE(Buffer(vCopy) != Buffer(vSmall));
+	TEST_TRUE((vCopy.Size() == 2) && (vCopy[1] == 2));
+
+	TArray<std::string> vStrings;
+
+	vStrings.Add("x");
+
+	TArray<std::string> vStrings2(vStrings);
+
+	vStrings2.Set(0, "y");
+
+	TEST_TRUE((vStrings[0] == "x") && (vStrings2[0] == "y"));
+}
+TEST_CASE_END
+
+TEST_CASE("Copying the same array on several threads at once shares one buffer")
+{
+	for (int n = 0; n != 50; ++n)
+	{
+		TArray<int> vArray;
+		HANDLE      ahThreads[NUM_THREADS];
+		DWORD       nErrors = 0;
+
+		FillArray(vArray, 10);
+
+		for (int t = 0; t != NUM_THREADS; ++t)
+			ahThreads[t] = reinterpret_cast<HANDLE>(_beginthreadex(NULL, 0, Copier, &vArray, 0, NULL));
+
+		for (int t = 0; t != NUM_THREADS; ++t)
+		{
+			DWORD nResult = 0;
+
+			::WaitForSingleObject(ahThreads[t], INFINITE);
+			::GetExitCodeThread(ahThreads[t], &nResult);
+			::CloseHandle(ahThreads[t]);
+
+			nErrors += nResult;
+		}
+
+		TEST_TRUE(nErrors == 0);
+
+		// Only this array should be left holding the buffer.
+		const int* pBuffer = Buffer(vArray);
+
+		vArray.Set(0, -1);
+
+		TEST_TRUE(Buffer(vArray) == pBuffer);
+	}
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
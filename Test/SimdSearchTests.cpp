@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   SimdSearchTests.cpp
+//! \brief  The unit tests for the CSimdSearch class and the TArray searches.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TArray.hpp>
+#include <Legacy/SimdSearch.hpp>
+
+namespace
+{
+
+//! The largest buffer searched, which spans several vectors plus a tail.
+const size_t MAX_ITEMS = 80;
+
+//! The largest misalignment of the start of the buffer.
+const size_t MAX_OFFSET = 3;
+
+//! The reference implementation of Find().
+template<class U>
+size_t ScalarFind(const U* pItems, size_t nCount, U nValue)
+{
+	for (size_t i = 0; i != nCount; ++i)
+	{
+		if (pItems[i] == nValue)
+			return i;
+	}
+
+	return Core::npos;
+}
+
+//! The reference implementation of FindLast().
+template<class U>
+size_t ScalarFindLast(const U* pItems, size_t nCount, U nValue)
+{
+	for (size_t i = nCount; i != 0; --i)
+	{
+		if (pItems[i-1] == nValue)
+			return i-1;
+	}
+
+	return Core::npos;
+}
+
+//! The reference implementation of Count().
+template<class U>
+size_t ScalarCount(const U* pItems, size_t nCount, U nValue)
+{
+	size_t nMatches = 0;
+
+	for (size_t i = 0; i != nCount; ++i)
+	{
+		if (pItems[i] == nValue)
+			++nMatches;
+	}
+
+	return nMatches;
+}
+
+//! Check the selected implementation agrees with the reference implementation
+//! for every buffer size and alignment and for values at every position.
+template<class U>
+bool MatchesScalar()
+{
+	U aBuffer[MAX_ITEMS + MAX_OFFSET];
+
+	for (size_t nOffset = 0; nOffset <= MAX_OFFSET; ++nOffset)
+	{
+		for (size_t nCount = 0; nCount <= MAX_ITEMS; ++nCount)
+		{
+			const U* pItems = aBuffer + nOffset;
+
+			for (size_t nMatch = 0; nMatch <= nCount; ++nMatch)
+			{
+				// Fill with duplicates of a few values and a single match.
+				for (size_t i = 0; i != (MAX_ITEMS + MAX_OFFSET); ++i)
+					aBuffer[i] = static_cast<U>((i % 5) + 1);
+
+				U nValue = static_cast<U>(~static_cast<U>(0));
+
+				if (nMatch != nCount)
+					aBuffer[nOffset + nMatch] = nValue;
+
+				size_t nSize = static_cast<size_t>(sizeof(U));
+				ULONGLONG nBits = TSimdSearchKey<U>::Bits(nValue);
+
+				if (CSimdSearch::Find(pItems, nCount, nSize, nBits) != ScalarFind(pItems, nCount, nValue))
+					return false;
+
+				if (CSimdSearch::FindLast(pItems, nCount, nSize, nBits) != ScalarFindLast(pItems, nCount, nValue))
+					return false;
+
+				if (CSimdSearch::Count(pItems, nCount, nSize, nBits) != ScalarCount(pItems, nCount, nValue))
+					return false;
+
+				// Search for one of the duplicated values.
+				U nDuplicate = static_cast<U>(3);
+				ULONGLONG nDupBits = TSimdSearchKey<U>::Bits(nDuplicate);
+
+				if (CSimdSearch::Find(pItems, nCount, nSize, nDupBits) != ScalarFind(pItems, nCount, nDuplicate))
+					return false;
+
+				if (CSimdSearch::FindLast(pItems, nCount, nSize, nDupBits) != ScalarFindLast(pItems, nCount, nDuplicate))
+					return false;
+
+				if (CSimdSearch::Count(pItems, nCount, nSize, nDupBits) != ScalarCount(pItems, nCount, nDuplicate))
+					return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+}
+
+TEST_SET(SimdSearch)
+{
+
+TEST_CASE("Searching an empty buffer finds nothing")
+{
+	int aItems[1] = { 0 };
+
+	TEST_TRUE(CSimdSearch::Find(aItems, 0, sizeof(int), 0) == Core::npos);
+	TEST_TRUE(CSimdSearch::FindLast(aItems, 0, sizeof(int), 0) == Core::npos);
+	TEST_TRUE(CSimdSearch::Count(aItems, 0, sizeof(int), 0) == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("The SIMD and scalar searches agree for every item size, length and alignment")
+{
+	TEST_TRUE(MatchesScalar<unsigned char>());
+	TEST_TRUE(MatchesScalar<unsigned short>());
+	TEST_TRUE(MatchesScalar<unsigned int>());
+	TEST_TRUE(MatchesScalar<ULONGLONG>());
+}
+TEST_CASE_END
+
+TEST_CASE("Signed values are matched on all their bits")
+{
+	TArray<short> vArray;
+
+	for (int i = 0; i != 50; ++i)
+		vArray.Add(static_cast<short>(-i));
+
+	TEST_TRUE(vArray.Find(-1) == 1);
+	TEST_TRUE(vArray.Find(-49) == 49);
+	TEST_TRUE(vArray.Find(1) == Core::npos);
+}
+TEST_CASE_END
+
+TEST_CASE("The array searches find the first, last and all duplicates")
+{
+	TArray<int> vArray;
+
+	for (int i = 0; i != 100; ++i)
+		vArray.Add(i % 10);
+
+	TArray<size_t> vIndices;
+
+	TEST_TRUE(vArray.Find(7) == 7);
+	TEST_TRUE(vArray.FindLast(7) == 97);
+	TEST_TRUE(vArray.Count(7) == 10);
+	TEST_TRUE(vArray.FindAll(7, vIndices) == 10);
+	TEST_TRUE(vIndices.Size() == 10);
+
+	for (size_t i = 0; i != vIndices.Size(); ++i)
+		TEST_TRUE(vIndices[i] == ((i * 10) + 7));
+
+	TEST_TRUE(vArray.Find(10) == Core::npos);
+	TEST_TRUE(vArray.FindLast(10) == Core::npos);
+	TEST_TRUE(vArray.Count(10) == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("Floating point values are compared by value rather than bitwise")
+{
+	TArray<double> vArray;
+
+	vArray.Add(1.0);
+	vArray.Add(-0.0);
+
+	TEST_TRUE(vArray.Find(0.0) == 1);
+	TEST_TRUE(vArray.Count(0.0) == 1);
+}
+TEST_CASE_END
+
+TEST_CASE("Pointers can be searched")
+{
+	int aValues[3] = { 0, 1, 2 };
+
+	TArray<int*> vArray;
+
+	for (size_t i = 0; i != 3; ++i)
+		vArray.Add(aValues + i);
+
+	vArray.Add(aValues);
+
+	TEST_TRUE(vArray.Find(aValues + 2) == 2);
+	TEST_TRUE(vArray.FindLast(aValues) == 3);
+	TEST_TRUE(vArray.Find(NULL) == Core::npos);
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
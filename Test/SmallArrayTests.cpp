@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   SmallArrayTests.cpp
+//! \brief  The unit tests for the TSmallArray class.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TSmallArray.hpp>
+#include <string>
+
+TEST_SET(SmallArray)
+{
+
+TEST_CASE("An empty small array already has the inline capacity")
+{
+	TSmallArray<int, 4> vArray;
+
+	TEST_TRUE(vArray.Size() == 0);
+	TEST_TRUE(vArray.Capacity() == 4);
+}
+TEST_CASE_END
+
+TEST_CASE("Items are stored inline until the inline capacity is exceeded")
+{
+	TSmallArray<int, 4> vArray;
+
+	for (int i = 0; i != 4; ++i)
+		vArray.Add(i);
+
+	const int* pInline = vArray.begin();
+
+	TEST_TRUE(vArray.Capacity() == 4);
+
+	vArray.Add(4);
+
+	TEST_TRUE(vArray.begin() != pInline);
+	TEST_TRUE(vArray.Capacity() > 4);
+
+	for (int i = 0; i != 5; ++i)
+		TEST_TRUE(vArray[i] == i);
+}
+TEST_CASE_END
+
+TEST_CASE("Shrinking back within the inline capacity moves the items inline")
+{
+	TSmallArray<int, 4> vArray;
+
+	const int* pInline = vArray.begin();
+
+	for (int i = 0; i != 10; ++i)
+		vArray.Add(i);
+
+	vArray.RemoveRange(3, 7);
+	vArray.ShrinkToFit();
+
+	TEST_TRUE(vArray.begin() == pInline);
+	TEST_TRUE(vArray.Capacity() == 4);
+	TEST_TRUE((vArray.Size() == 3) && (vArray[0] == 0) && (vArray[2] == 2));
+
+	for (int i = 0; i != 100; ++i)
+		vArray.Insert(0, i);
+
+	vArray.RemoveAll();
+
+	TEST_TRUE(vArray.begin() == pInline);
+	TEST_TRUE(vArray.Capacity() == 4);
+}
+TEST_CASE_END
+
+TEST_CASE("Inserting the array's own items when spilling to the heap copies them first")
+{
+	TSmallArray<int, 4> vArray;
+
+	for (int i = 0; i != 3; ++i)
+		vArray.Add(i);
+
+	vArray.InsertRange(1, vArray.begin(), vArray.end());
+
+	const int aExpected[] = { 0, 0, 1, 2, 1, 2 };
+
+	TEST_TRUE(vArray.Size() == 6);
+
+	for (size_t i = 0; i != 6; ++i)
+		TEST_TRUE(vArray[i] == aExpected[i]);
+}
+TEST_CASE_END
+
+TEST_CASE("Items which are not trivially copyable survive the move to and from the heap")
+{
+	TSmallArray<std::string, 2> vArray;
+
+	vArray.Add("one");
+	vArray.Add("two");
+	vArray.Add("three");
+
+	TEST_TRUE(vArray[0] == "one");
+	TEST_TRUE(vArray[2] == "three");
+
+	vArray.Remove(0);
+	vArray.ShrinkToFit();
+
+	TEST_TRUE((vArray[0] == "two") && (vArray[1] == "three"));
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
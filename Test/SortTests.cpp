@@ -0,0 +1,284 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   SortTests.cpp
+//! \brief  The unit tests for the TArray sorting methods.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TArray.hpp>
+#include <functional>
+#include <limits.h>
+
+namespace
+{
+
+//! An item with a key and a value to check the sort stability.
+struct Pair
+{
+	int m_nKey;
+	int m_nValue;
+};
+
+//! Compare the keys of two pairs.
+struct KeyLess
+{
+	bool operator()(const Pair& oLHS, const Pair& oRHS) const
+	{
+		return (oLHS.m_nKey < oRHS.m_nKey);
+	}
+};
+
+//! The radix sort key extractor for a pair.
+int KeyOf(const Pair& oPair)
+{
+	return oPair.m_nKey;
+}
+
+//! The qsort() style comparison function.
+int CompareInts(const int* pLHS, const int* pRHS)
+{
+	return (*pLHS < *pRHS) ? -1 : ((*pLHS > *pRHS) ? 1 : 0);
+}
+
+//! Create an array with duplicate values in a scrambled order.
+void FillArray(TArray<int>& vArray, size_t nCount)
+{
+	for (size_t i = 0; i != nCount; ++i)
+		vArray.Add(static_cast<int>((i * 7919) % 97) - 48);
+}
+
+//! Check if the array is in ascending order.
+bool IsSorted(const TArray<int>& vArray)
+{
+	for (size_t i = 1; i < vArray.Size(); ++i)
+	{
+		if (vArray[i] < vArray[i-1])
+			return false;
+	}
+
+	return true;
+}
+
+}
+
+TEST_SET(Sort)
+{
+
+TEST_CASE("Sorting an empty array or a single item does nothing")
+{
+	TArray<int> vArray;
+
+	vArray.Sort();
+	vArray.StableSort();
+	vArray.Sort(CompareInts);
+
+	TEST_TRUE(vArray.Size() == 0);
+
+	vArray.Add(42);
+	vArray.Sort();
+
+	TEST_TRUE((vArray.Size() == 1) && (vArray[0] == 42));
+}
+TEST_CASE_END
+
+TEST_CASE("Sorting orders the items and keeps any duplicates")
+{
+	TArray<int> vArray;
+
+	FillArray(vArray, 1000);
+	vArray.Sort();
+
+	TEST_TRUE(vArray.Size() == 1000);
+	TEST_TRUE(IsSorted(vArray));
+	TEST_TRUE(vArray.Count(vArray[0]) > 1);
+}
+TEST_CASE_END
+
+TEST_CASE("Sorting with a comparator uses the comparator's order")
+{
+	TArray<int> vArray;
+
+	FillArray(vArray, 100);
+	vArray.Sort(std::greater<int>());
+
+	for (size_t i = 1; i != vArray.Size(); ++i)
+		TEST_TRUE(vArray[i-1] >= vArray[i]);
+}
+TEST_CASE_END
+
+TEST_CASE("Sorting with a compare function matches the default order")
+{
+	TArray<int> vArray1;
+	TArray<int> vArray2;
+
+	FillArray(vArray1, 500);
+	FillArray(vArray2, 500);
+
+	vArray1.Sort(CompareInts);
+	vArray2.Sort();
+
+	TEST_TRUE(IsSorted(vArray1));
+
+	for (size_t i = 0; i != vArray1.Size(); ++i)
+		TEST_TRUE(vArray1[i] == vArray2[i]);
+}
+TEST_CASE_END
+
+TEST_CASE("A stable sort keeps equal items in their original order")
+{
+	TArray<Pair> vArray;
+
+	for (int i = 0; i != 200; ++i)
+	{
+		Pair oPair = { i % 5, i };
+
+		vArray.Add(oPair);
+	}
+
+	vArray.StableSort(KeyLess());
+
+	for (size_t i = 1; i != vArray.Size(); ++i)
+	{
+		TEST_TRUE(vArray[i-1].m_nKey <= vArray[i].m_nKey);
+
+		if (vArray[i-1].m_nKey == vArray[i].m_nKey)
+			TEST_TRUE(vArray[i-1].m_nValue < vArray[i].m_nValue);
+	}
+}
+TEST_CASE_END
+
+TEST_CASE("A radix sort of an empty array or a single item does nothing")
+{
+	TArray<int> vArray;
+
+	vArray.RadixSort();
+
+	TEST_TRUE(vArray.Size() == 0);
+
+	vArray.Add(-1);
+	vArray.RadixSort();
+
+	TEST_TRUE((vArray.Size() == 1) && (vArray[0] == -1));
+}
+TEST_CASE_END
+
+TEST_CASE("A radix sort orders signed integers the same as a comparison sort")
+{
+	TArray<int> vArray1;
+	TArray<int> vArray2;
+
+	FillArray(vArray1, 1000);
+	vArray1.Add(INT_MIN);
+	vArray1.Add(INT_MAX);
+	vArray2.AddRange(vArray1);
+
+	vArray1.RadixSort();
+	vArray2.Sort();
+
+	TEST_TRUE(vArray1[0] == INT_MIN);
+
+	for (size_t i = 0; i != vArray1.Size(); ++i)
+		TEST_TRUE(vArray1[i] == vArray2[i]);
+}
+TEST_CASE_END
+
+TEST_CASE("A radix sort orders negative and positive floating point values")
+{
+	TArray<double> vArray;
+
+	for (int i = 0; i != 200; ++i)
+		vArray.Add(((i * 37) % 101 - 50) / 3.0);
+
+	vArray.Add(0.0);
+	vArray.Add(-0.5);
+	vArray.RadixSort();
+
+	for (size_t i = 1; i != vArray.Size(); ++i)
+		TEST_TRUE(vArray[i-1] <= vArray[i]);
+}
+TEST_CASE_END
+
+TEST_CASE("A radix sort on an extracted key keeps equal keys in their original order")
+{
+	TArray<Pair> vArray;
+
+	for (int i = 0; i != 300; ++i)
+	{
+		Pair oPair = { (i % 7) - 3, i };
+
+		vArray.Add(oPair);
+	}
+
+	vArray.RadixSort(KeyOf);
+
+	for (size_t i = 1; i != vArray.Size(); ++i)
+	{
+		TEST_TRUE(vArray[i-1].m_nKey <= vArray[i].m_nKey);
+
+		if (vArray[i-1].m_nKey == vArray[i].m_nKey)
+			TEST_TRUE(vArray[i-1].m_nValue < vArray[i].m_nValue);
+	}
+}
+TEST_CASE_END
+
+#ifdef LEGACY_HAS_CXX11
+
+TEST_CASE("A radix sort can extract the key with a lambda")
+{
+	TArray<Pair> vArray;
+
+	for (int i = 0; i != 300; ++i)
+	{
+		Pair oPair = { 1000 - ((i * 37) % 500), i };
+
+		vArray.Add(oPair);
+	}
+
+	vArray.RadixSort([](const Pair& oPair) -> const int& { return oPair.m_nKey; });
+
+	for (size_t i = 1; i != vArray.Size(); ++i)
+		TEST_TRUE(vArray[i-1].m_nKey <= vArray[i].m_nKey);
+}
+TEST_CASE_END
+
+#endif
+
+TEST_CASE("A parallel sort of an empty or small array sorts on the calling thread")
+{
+	TArray<int> vArray;
+
+	vArray.ParallelSort();
+
+	TEST_TRUE(vArray.Size() == 0);
+
+	FillArray(vArray, 100);
+	vArray.ParallelSort(std::less<int>(), 4);
+
+	TEST_TRUE(vArray.Size() == 100);
+	TEST_TRUE(IsSorted(vArray));
+}
+TEST_CASE_END
+
+TEST_CASE("A parallel sort with several threads matches a serial sort")
+{
+	TArray<int> vArray1;
+	TArray<int> vArray2;
+
+	FillArray(vArray1, 200001);
+	vArray2.AddRange(vArray1);
+
+	vArray1.ParallelSort(std::less<int>(), 3);
+	vArray2.Sort();
+
+	TEST_TRUE(vArray1.Size() == vArray2.Size());
+
+	bool bSame = true;
+
+	for (size_t i = 0; i != vArray1.Size(); ++i)
+		bSame = bSame && (vArray1[i] == vArray2[i]);
+
+	TEST_TRUE(bSame);
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   SortedArrayTests.cpp
+//! \brief  The unit tests for the TSortedArray class.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TSortedArray.hpp>
+
+namespace
+{
+
+//! An item with a key and a value to check the order of equal items.
+struct Pair
+{
+	int m_nKey;
+	int m_nValue;
+};
+
+//! Compare the keys of two pairs.
+struct KeyLess
+{
+	bool operator()(const Pair& oLHS, const Pair& oRHS) const
+	{
+		return (oLHS.m_nKey < oRHS.m_nKey);
+	}
+};
+
+//! Make a pair.
+Pair MakePair(int nKey, int nValue)
+{
+	Pair oPair = { nKey, nValue };
+
+	return oPair;
+}
+
+//! Check that both search layouts return the same results.
+bool LayoutsAgree(TSortedArray<int>& vArray, int nMin, int nMax)
+{
+	for (int i = nMin; i <= nMax; ++i)
+	{
+		vArray.SetSearchLayout(TSortedArray<int>::SEARCH_BINARY);
+
+		size_t nLower = vArray.LowerBound(i);
+		size_t nUpper = vArray.UpperBound(i);
+		size_t nFound = vArray.Find(i);
+
+		vArray.SetSearchLayout(TSortedArray<int>::SEARCH_EYTZINGER);
+
+		if ( (vArray.LowerBound(i) != nLower) || (vArray.UpperBound(i) != nUpper) || (vArray.Find(i) != nFound) )
+			return false;
+	}
+
+	return true;
+}
+
+}
+
+TEST_SET(SortedArray)
+{
+
+TEST_CASE("Searching an empty array finds nothing with either layout")
+{
+	TSortedArray<int> vArray;
+
+	TEST_TRUE(vArray.Find(1) == Core::npos);
+	TEST_TRUE(vArray.LowerBound(1) == 0);
+	TEST_TRUE(vArray.UpperBound(1) == 0);
+
+	vArray.SetSearchLayout(TSortedArray<int>::SEARCH_EYTZINGER);
+
+	TEST_TRUE(vArray.Find(1) == Core::npos);
+	TEST_FALSE(vArray.Contains(1));
+	TEST_TRUE(vArray.LowerBound(1) == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("Inserted items are kept in order")
+{
+	TSortedArray<int> vArray;
+
+	const int aItems[] = { 5, 3, 9, 1, 7 };
+
+	for (size_t i = 0; i != 5; ++i)
+		vArray.Insert(aItems[i]);
+
+	TEST_TRUE(vArray.Size() == 5);
+
+	for (size_t i = 0; i != 5; ++i)
+		TEST_TRUE(vArray[i] == static_cast<int>((i * 2) + 1));
+
+	TEST_TRUE(vArray.Find(7) == 3);
+	TEST_TRUE(vArray.Find(4) == Core::npos);
+}
+TEST_CASE_END
+
+TEST_CASE("Duplicates are found by their first index and bounded by the upper bound")
+{
+	TSortedArray<int> vArray;
+
+	for (int i = 0; i != 30; ++i)
+		vArray.Insert(i % 3);
+
+	TEST_TRUE(vArray.Find(0) == 0);
+	TEST_TRUE(vArray.Find(1) == 10);
+	TEST_TRUE(vArray.LowerBound(2) == 20);
+	TEST_TRUE(vArray.UpperBound(2) == 30);
+	TEST_TRUE(vArray.UpperBound(-1) == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("Equal items are kept in the order they were added or merged")
+{
+	TSortedArray<Pair, KeyLess> vArray;
+
+	vArray.Insert(MakePair(1, 0));
+	vArray.Insert(MakePair(0, 1));
+	vArray.Insert(MakePair(1, 2));
+
+	const Pair aItems[] = { MakePair(0, 3), MakePair(1, 4), MakePair(2, 5) };
+
+	vArray.Merge(aItems, 3);
+
+	const int aExpected[] = { 1, 3, 0, 2, 4, 5 };
+
+	TEST_TRUE(vArray.Size() == 6);
+
+	for (size_t i = 0; i != 6; ++i)
+		TEST_TRUE(vArray[i].m_nValue == aExpected[i]);
+}
+TEST_CASE_END
+
+TEST_CASE("Merging an empty range or the array's own items keeps it sorted")
+{
+	TSortedArray<int> vArray;
+
+	for (int i = 0; i != 10; ++i)
+		vArray.Insert(i);
+
+	vArray.Merge(vArray.begin(), 0);
+
+	TEST_TRUE(vArray.Size() == 10);
+
+	vArray.Merge(vArray.begin() + 2, 3);
+
+	const int aExpected[] = { 0, 1, 2, 2, 3, 3, 4, 4, 5, 6, 7, 8, 9 };
+
+	TEST_TRUE(vArray.Size() == 13);
+
+	for (size_t i = 0; i != 13; ++i)
+		TEST_TRUE(vArray[i] == aExpected[i]);
+}
+TEST_CASE_END
+
+TEST_CASE("The binary and Eytzinger layouts return the same results")
+{
+	TSortedArray<int> vArray;
+
+	TEST_TRUE(LayoutsAgree(vArray, -1, 1));
+
+	for (int n = 1; n != 40; ++n)
+	{
+		vArray.Insert((n * 7) % 13);
+
+		TEST_TRUE(LayoutsAgree(vArray, -1, 14));
+	}
+
+	vArray.RemoveRange(5, 10);
+
+	TEST_TRUE(LayoutsAgree(vArray, -1, 14));
+
+	vArray.RemoveAll();
+
+	TEST_TRUE(LayoutsAgree(vArray, -1, 1));
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
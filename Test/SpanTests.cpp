@@ -0,0 +1,211 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   SpanTests.cpp
+//! \brief  The unit tests for TSpan and the TArray buffer ownership methods.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TSmallArray.hpp>
+#include <stdlib.h>
+#include <vector>
+
+namespace
+{
+
+//! Create an array holding the values 0..N-1.
+void FillArray(TArray<int>& vArray, int nCount)
+{
+	for (int i = 0; i != nCount; ++i)
+		vArray.Add(i);
+}
+
+//! Sum the items in a read-only view.
+int Sum(TSpan<const int> oSpan)
+{
+	int nSum = 0;
+
+	for (TSpan<const int>::iterator it = oSpan.begin(); it != oSpan.end(); ++it)
+		nSum += *it;
+
+	return nSum;
+}
+
+}
+
+TEST_SET(Span)
+{
+
+TEST_CASE("A default constructed span is empty")
+{
+	TSpan<int> oSpan;
+
+	TEST_TRUE(oSpan.Empty());
+	TEST_TRUE(oSpan.Size() == 0);
+	TEST_TRUE(oSpan.Data() == NULL);
+	TEST_TRUE(oSpan.begin() == oSpan.end());
+}
+TEST_CASE_END
+
+TEST_CASE("A span can be created from a pointer and size, including an empty one")
+{
+	int anItems[] = { 1, 2, 3 };
+
+	TSpan<int> oSpan(anItems, 3);
+	TSpan<int> oEmpty(anItems, 0);
+	TSpan<int> oNull(NULL, 0);
+
+	TEST_TRUE((oSpan.Size() == 3) && (oSpan[2] == 3) && (oSpan.At(0) == 1));
+	TEST_TRUE(oEmpty.Empty() && (oEmpty.Data() == anItems));
+	TEST_TRUE(oNull.Empty());
+}
+TEST_CASE_END
+
+TEST_CASE("A span can be created from a half-open range")
+{
+	int anItems[] = { 1, 2, 3, 4 };
+
+	TSpan<int> oSpan = TSpan<int>::FromRange(anItems + 1, anItems + 4);
+	TSpan<int> oEmpty = TSpan<int>::FromRange(anItems + 2, anItems + 2);
+
+	TEST_TRUE((oSpan.Size() == 3) && (oSpan[0] == 2) && (oSpan[2] == 4));
+	TEST_TRUE(oEmpty.Empty());
+}
+TEST_CASE_END
+
+TEST_CASE("Writing through a span changes the viewed items")
+{
+	TArray<int> vArray;
+
+	FillArray(vArray, 5);
+
+	TSpan<int> oSpan = vArray.Span();
+
+	oSpan[4] = 40;
+
+	TEST_TRUE(vArray[4] == 40);
+	TEST_TRUE(oSpan.Data() == vArray.begin());
+}
+TEST_CASE_END
+
+TEST_CASE("A span converts to a read-only span of the same items")
+{
+	TArray<int> vArray;
+
+	FillArray(vArray, 5);
+
+	TSpan<int>       oSpan = vArray.Span();
+	TSpan<const int> oConst = oSpan;
+
+	const TArray<int>& vConstArray = vArray;
+
+	TEST_TRUE((oConst.Data() == oSpan.Data()) && (oConst.Size() == oSpan.Size()));
+	TEST_TRUE(Sum(oSpan) == 10);
+	TEST_TRUE(Sum(vConstArray.Span()) == 10);
+}
+TEST_CASE_END
+
+TEST_CASE("A subspan views part of the items and may be empty at either end")
+{
+	TArray<int> vArray;
+
+	FillArray(vArray, 10);
+
+	TSpan<int> oSpan = vArray.Span();
+	TSpan<int> oMiddle = oSpan.Subspan(2, 3);
+
+	TEST_TRUE((oMiddle.Size() == 3) && (oMiddle[0] == 2) && (oMiddle[2] == 4));
+	TEST_TRUE(oSpan.Subspan(0, 0).Empty());
+	TEST_TRUE(oSpan.Subspan(10, 0).Empty());
+	TEST_TRUE(oSpan.Subspan(0, 10).Size() == 10);
+}
+TEST_CASE_END
+
+TEST_CASE("An array can be constructed from a range, including an empty one")
+{
+	std::vector<int> vItems;
+
+	for (int i = 0; i != 5; ++i)
+		vItems.push_back(i * 2);
+
+	TArray<int> vArray(&vItems[0], &vItems[0] + vItems.size());
+	TArray<int> vEmpty(&vItems[0], &vItems[0]);
+
+	TEST_TRUE((vArray.Size() == 5) && (vArray[0] == 0) && (vArray[4] == 8));
+	TEST_TRUE(vArray.Capacity() >= 5);
+	TEST_TRUE((vEmpty.Size() == 0));
+}
+TEST_CASE_END
+
+TEST_CASE("Detaching the buffer leaves the array empty and attaching it restores the items")
+{
+	TArray<int> vArray1;
+	TArray<int> vArray2;
+
+	FillArray(vArray1, 10);
+
+	size_t nSize, nCapacity;
+	int*   pItems = vArray1.Detach(nSize, nCapacity);
+
+	TEST_TRUE((vArray1.Size() == 0) && (vArray1.Capacity() == 0));
+	TEST_TRUE((pItems != NULL) && (nSize == 10) && (nCapacity >= 10));
+
+	FillArray(vArray2, 3);
+	vArray2.Attach(pItems, nSize, nCapacity);
+
+	TEST_TRUE((vArray2.Size() == 10) && (vArray2[9] == 9));
+	TEST_TRUE(vArray2.Capacity() == nCapacity);
+}
+TEST_CASE_END
+
+TEST_CASE("Detaching an empty array returns no buffer")
+{
+	TArray<int> vArray;
+
+	size_t nSize = 1, nCapacity = 1;
+
+	vArray.Reserve(10);
+
+	TEST_TRUE(vArray.Detach(nSize, nCapacity) == NULL);
+	TEST_TRUE((nSize == 0) && (nCapacity == 0));
+	TEST_TRUE(vArray.Capacity() == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("Detaching a shared buffer unshares it first")
+{
+	TArray<int> vArray1;
+
+	FillArray(vArray1, 10);
+
+	TArray<int> vArray2(vArray1);
+
+	size_t nSize, nCapacity;
+	int*   pItems = vArray2.Detach(nSize, nCapacity);
+
+	TEST_TRUE(pItems != vArray1.begin());
+	TEST_TRUE((nSize == 10) && (pItems[9] == 9));
+	TEST_TRUE((vArray1.Size() == 10) && (vArray1[9] == 9));
+
+	free(pItems);
+}
+TEST_CASE_END
+
+TEST_CASE("Detaching an inline buffer moves the items to the heap")
+{
+	TSmallArray<int, 8> vArray;
+
+	FillArray(vArray, 4);
+
+	const int* pInline = vArray.begin();
+
+	size_t nSize, nCapacity;
+	int*   pItems = vArray.Detach(nSize, nCapacity);
+
+	TEST_TRUE(pItems != pInline);
+	TEST_TRUE((nSize == 4) && (pItems[3] == 3));
+
+	free(pItems);
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
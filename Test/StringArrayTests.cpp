@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   StringArrayTests.cpp
+//! \brief  The unit tests for the TStringArray class.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TStringArray.hpp>
+#include <string.h>
+
+namespace
+{
+
+typedef TStringArray<char> CStringArray;
+
+//! Query if a string in the array has the expected value.
+bool IsEqual(const CStringArray& oArray, size_t nIndex, const char* pszValue)
+{
+	return (oArray.Length(nIndex) == strlen(pszValue)) && (strcmp(oArray.CStr(nIndex), pszValue) == 0);
+}
+
+}
+
+TEST_SET(StringArray)
+{
+
+TEST_CASE("A default constructed array is empty")
+{
+	CStringArray oArray;
+	TArray<size_t> vOrder;
+
+	TEST_TRUE(oArray.Size() == 0);
+	TEST_TRUE(oArray.NumChars() == 0);
+	TEST_TRUE(oArray.Find("") == Core::npos);
+
+	oArray.GetSortedOrder(vOrder);
+	oArray.Sort();
+
+	TEST_TRUE(vOrder.Size() == 0);
+	TEST_TRUE(oArray.Size() == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("Strings are stored null terminated and viewed without the terminator")
+{
+	CStringArray oArray;
+
+	TEST_TRUE(oArray.Add("abc") == 0);
+	TEST_TRUE(oArray.Add("") == 1);
+	TEST_TRUE(oArray.Add("xyz!", 2) == 2);
+
+	TEST_TRUE(oArray.Size() == 3);
+	TEST_TRUE(oArray.NumChars() == 4 + 1 + 3);
+
+	TEST_TRUE(IsEqual(oArray, 0, "abc"));
+	TEST_TRUE(IsEqual(oArray, 1, ""));
+	TEST_TRUE(IsEqual(oArray, 2, "xy"));
+
+	TSpan<const char> oSpan = oArray.At(0);
+
+	TEST_TRUE((oSpan.Size() == 3) && (oSpan[0] == 'a') && (oSpan[2] == 'c'));
+	TEST_TRUE(oArray[1].Empty());
+}
+TEST_CASE_END
+
+TEST_CASE("Finding a string returns the first match, including an empty string")
+{
+	CStringArray oArray;
+
+	oArray.Add("b");
+	oArray.Add("");
+	oArray.Add("ab");
+	oArray.Add("b");
+	oArray.Add("");
+
+	TEST_TRUE(oArray.Find("b") == 0);
+	TEST_TRUE(oArray.Find("") == 1);
+	TEST_TRUE(oArray.Find("ab") == 2);
+	TEST_TRUE(oArray.Find("a") == Core::npos);
+	TEST_TRUE(oArray.Find("abc") == Core::npos);
+}
+TEST_CASE_END
+
+TEST_CASE("Strings compare by character code and then by length")
+{
+	CStringArray oArray;
+
+	oArray.Add("ab");
+	oArray.Add("abc");
+	oArray.Add("ab");
+	oArray.Add("b");
+	oArray.Add("");
+
+	TEST_TRUE(oArray.Compare(0, 2) == 0);
+	TEST_TRUE(oArray.Compare(0, 1) < 0);
+	TEST_TRUE(oArray.Compare(1, 0) > 0);
+	TEST_TRUE(oArray.Compare(1, 3) < 0);
+	TEST_TRUE(oArray.Compare(4, 0) < 0);
+	TEST_TRUE(oArray.Compare(4, 4) == 0);
+
+	TEST_TRUE(oArray.Equals(0, "ab", 2));
+	TEST_FALSE(oArray.Equals(0, "abc", 3));
+	TEST_TRUE(oArray.Equals(4, "", 0));
+}
+TEST_CASE_END
+
+TEST_CASE("Adding an array appends its strings, including to itself")
+{
+	CStringArray oArray1;
+	CStringArray oArray2;
+
+	oArray1.Add("one");
+	oArray1.Add("");
+	oArray2.Add("two");
+
+	TEST_TRUE(oArray2.AddRange(oArray1) == 1);
+	TEST_TRUE(oArray2.Size() == 3);
+	TEST_TRUE(IsEqual(oArray2, 0, "two"));
+	TEST_TRUE(IsEqual(oArray2, 1, "one"));
+	TEST_TRUE(IsEqual(oArray2, 2, ""));
+
+	TEST_TRUE(oArray2.AddRange(oArray2) == 3);
+	TEST_TRUE(oArray2.Size() == 6);
+	TEST_TRUE(oArray2.NumChars() == 2 * (4 + 4 + 1));
+
+	for (size_t i = 0; i != 3; ++i)
+		TEST_TRUE(oArray2.Compare(i, i + 3) == 0);
+
+	CStringArray oEmpty;
+
+	TEST_TRUE(oArray2.AddRange(oEmpty) == 6);
+	TEST_TRUE(oArray2.Size() == 6);
+}
+TEST_CASE_END
+
+TEST_CASE("The sorted order leaves the strings where they are")
+{
+	CStringArray oArray;
+	TArray<size_t> vOrder;
+
+	oArray.Add("pear");
+	oArray.Add("apple");
+	oArray.Add("");
+	oArray.Add("apple");
+	oArray.Add("app");
+
+	oArray.GetSortedOrder(vOrder);
+
+	TEST_TRUE(vOrder.Size() == 5);
+	TEST_TRUE(vOrder[0] == 2);
+	TEST_TRUE(vOrder[1] == 4);
+	TEST_TRUE((vOrder[2] == 1) || (vOrder[2] == 3));
+	TEST_TRUE(vOrder[4] == 0);
+	TEST_TRUE(IsEqual(oArray, 0, "pear"));
+}
+TEST_CASE_END
+
+TEST_CASE("Sorting the strings reorders them, including duplicates and empty strings")
+{
+	CStringArray oArray;
+
+	oArray.Add("pear");
+	oArray.Add("apple");
+	oArray.Add("");
+	oArray.Add("apple");
+	oArray.Add("app");
+
+	size_t nChars = oArray.NumChars();
+
+	oArray.Sort();
+
+	TEST_TRUE(oArray.Size() == 5);
+	TEST_TRUE(oArray.NumChars() == nChars);
+	TEST_TRUE(IsEqual(oArray, 0, ""));
+	TEST_TRUE(IsEqual(oArray, 1, "app"));
+	TEST_TRUE(IsEqual(oArray, 2, "apple"));
+	TEST_TRUE(IsEqual(oArray, 3, "apple"));
+	TEST_TRUE(IsEqual(oArray, 4, "pear"));
+
+	TEST_TRUE(oArray.Find("pear") == 4);
+}
+TEST_CASE_END
+
+TEST_CASE("Removing all the strings empties the array")
+{
+	CStringArray oArray;
+
+	oArray.Add("abc");
+	oArray.RemoveAll();
+
+	TEST_TRUE(oArray.Size() == 0);
+	TEST_TRUE(oArray.NumChars() == 0);
+	TEST_TRUE(oArray.Find("abc") == Core::npos);
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
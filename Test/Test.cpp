@@ -0,0 +1,38 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   Test.cpp
+//! \brief  The test harness entry point.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <tchar.h>
+
+////////////////////////////////////////////////////////////////////////////////
+//! The entry point for the test harness.
+
+int _tmain(int argc, _TCHAR* argv[])
+{
+	TEST_SUITE(argc, argv)
+	{
+		TEST_SUITE_RUN(Array);
+		TEST_SUITE_RUN(PtrArray);
+		TEST_SUITE_RUN(Sort);
+		TEST_SUITE_RUN(SmallArray);
+		TEST_SUITE_RUN(ArrayAllocator);
+		TEST_SUITE_RUN(ObjectArray);
+		TEST_SUITE_RUN(SharedArray);
+		TEST_SUITE_RUN(SimdSearch);
+		TEST_SUITE_RUN(SortedArray);
+		TEST_SUITE_RUN(RingArray);
+		TEST_SUITE_RUN(GapArray);
+		TEST_SUITE_RUN(ArrayView);
+		TEST_SUITE_RUN(SegmentedArray);
+		TEST_SUITE_RUN(ConcurrentArray);
+		TEST_SUITE_RUN(BitArray);
+		TEST_SUITE_RUN(PackedIntArray);
+		TEST_SUITE_RUN(TopK);
+		TEST_SUITE_RUN(Span);
+		TEST_SUITE_RUN(StringArray);
+		TEST_SUITE_RUN(IndexedArray);
+	}
+	TEST_SUITE_END
+}
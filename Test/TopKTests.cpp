@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////
+//! \file   TopKTests.cpp
+//! \brief  The unit tests for TTopK and the TArray partial sorts.
+//! \author Chris Oldwood
+
+#include "Common.hpp"
+#include <Legacy/TTopK.hpp>
+#include <functional>
+
+namespace
+{
+
+//! Create an array with duplicate values in a scrambled order.
+void FillArray(TArray<int>& vArray, size_t nCount)
+{
+	for (size_t i = 0; i != nCount; ++i)
+		vArray.Add(static_cast<int>((i * 7919) % 101));
+}
+
+}
+
+TEST_SET(TopK)
+{
+
+TEST_CASE("A partial sort orders the first items and keeps the rest")
+{
+	TArray<int> vArray;
+	TArray<int> vSorted;
+
+	FillArray(vArray, 500);
+	vSorted.AddRange(vArray);
+	vSorted.Sort();
+
+	vArray.PartialSort(20);
+
+	for (size_t i = 0; i != 20; ++i)
+		TEST_TRUE(vArray[i] == vSorted[i]);
+
+	vArray.Sort();
+
+	for (size_t i = 0; i != vArray.Size(); ++i)
+		TEST_TRUE(vArray[i] == vSorted[i]);
+}
+TEST_CASE_END
+
+TEST_CASE("A partial sort of none or all of the items is allowed")
+{
+	TArray<int> vArray;
+
+	vArray.PartialSort(0);
+
+	FillArray(vArray, 50);
+	vArray.PartialSort(0);
+	vArray.PartialSort(vArray.Size(), std::greater<int>());
+
+	for (size_t i = 1; i != vArray.Size(); ++i)
+		TEST_TRUE(vArray[i-1] >= vArray[i]);
+}
+TEST_CASE_END
+
+TEST_CASE("The nth element partitions the items around the sorted value")
+{
+	TArray<int> vArray;
+	TArray<int> vSorted;
+
+	FillArray(vArray, 500);
+	vSorted.AddRange(vArray);
+	vSorted.Sort();
+
+	const size_t aIndices[] = { 0, 1, 250, 498, 499 };
+
+	for (size_t n = 0; n != 5; ++n)
+	{
+		size_t nIndex = aIndices[n];
+
+		vArray.NthElement(nIndex);
+
+		TEST_TRUE(vArray[nIndex] == vSorted[nIndex]);
+
+		for (size_t i = 0; i != nIndex; ++i)
+			TEST_TRUE(vArray[i] <= vArray[nIndex]);
+
+		for (size_t i = nIndex + 1; i != vArray.Size(); ++i)
+			TEST_TRUE(vArray[i] >= vArray[nIndex]);
+	}
+}
+TEST_CASE_END
+
+TEST_CASE("The top K keeps the greatest items, including duplicates, greatest first")
+{
+	TTopK<int> oTopK(10);
+	TArray<int> vAll;
+
+	FillArray(vAll, 1000);
+
+	for (size_t i = 0; i != vAll.Size(); ++i)
+		oTopK.Add(vAll[i]);
+
+	vAll.Sort(std::greater<int>());
+
+	TArray<int> vItems;
+
+	oTopK.GetItems(vItems);
+
+	TEST_TRUE(oTopK.Size() == 10);
+	TEST_TRUE(vItems.Size() == 10);
+	TEST_TRUE(oTopK.Least() == vAll[9]);
+
+	for (size_t i = 0; i != 10; ++i)
+		TEST_TRUE(vItems[i] == vAll[i]);
+}
+TEST_CASE_END
+
+TEST_CASE("The top K of fewer than K items keeps all of them")
+{
+	TTopK<int, std::greater<int> > oBottomK(5, std::greater<int>());
+
+	TEST_TRUE(oBottomK.Size() == 0);
+
+	TEST_TRUE(oBottomK.Add(3));
+	TEST_TRUE(oBottomK.Add(1));
+	TEST_TRUE(oBottomK.Add(2));
+
+	TArray<int> vItems;
+
+	vItems.Add(-1);
+	oBottomK.GetItems(vItems);
+
+	TEST_TRUE(vItems.Size() == 4);
+	TEST_TRUE((vItems[0] == -1) && (vItems[1] == 1) && (vItems[2] == 2) && (vItems[3] == 3));
+
+	oBottomK.RemoveAll();
+
+	TEST_TRUE(oBottomK.Size() == 0);
+}
+TEST_CASE_END
+
+TEST_CASE("A top K of zero items keeps nothing")
+{
+	TTopK<int> oTopK(0);
+
+	TEST_FALSE(oTopK.Add(1));
+	TEST_TRUE(oTopK.Size() == 0);
+}
+TEST_CASE_END
+
+}
+TEST_SET_END
@@ -0,0 +1,121 @@
+/******************************************************************************
+** (C) Chris Oldwood
+**
+** MODULE:		TYPETRAITS.HPP
+** COMPONENT:	Windows C++ Library.
+** DESCRIPTION:	The type traits used to select the collection implementations.
+**
+*******************************************************************************
+*/
+
+// Check for previous inclusion
+#ifndef TYPETRAITS_HPP
+#define TYPETRAITS_HPP
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+// Compiler supports rvalue references and variadic templates?
+#if (__cplusplus >= 201103L) || (_MSC_VER >= 1800)
+#define LEGACY_HAS_CXX11
+#endif
+
+#ifdef LEGACY_HAS_CXX11
+#include <type_traits>
+#include <utility>
+#endif
+
+/******************************************************************************
+**
+** The types used to select an overload at compile time.
+**
+*******************************************************************************
+*/
+
+template<bool B> struct TBoolType
+{
+	enum { VALUE = B };
+};
+
+typedef TBoolType<true>  TrueType;
+typedef TBoolType<false> FalseType;
+
+/******************************************************************************
+**
+** The traits class used to determine if a type can be copied, moved and
+** destroyed bytewise, i.e. with memcpy() and without running any constructors
+** or destructors.
+**
+*******************************************************************************
+*/
+
+template<class T> struct TIsTrivial
+{
+#ifdef LEGACY_HAS_CXX11
+	enum { VALUE = std::is_trivially_copyable<T>::value };
+#else
+	enum { VALUE = __has_trivial_copy(T) && __has_trivial_assign(T) && __has_trivial_destructor(T) };
+#endif
+
+	typedef TBoolType<VALUE> Type;
+};
+
+/******************************************************************************
+**
+** The traits class used to get the type without a const qualifier.
+**
+*******************************************************************************
+*/
+
+template<class T> struct TRemoveConst
+{
+	typedef T Type;
+};
+
+template<class T> struct TRemoveConst<const T>
+{
+	typedef T Type;
+};
+
+/******************************************************************************
+**
+** The class used to check a condition at compile time, e.g.
+**
+**   (void)sizeof(TStaticAssert<TIsTrivial<T>::VALUE>);
+**
+** This fails to compile if the condition is false.
+**
+*******************************************************************************
+*/
+
+template<bool B> struct TStaticAssert;
+
+template<> struct TStaticAssert<true>
+{
+};
+
+/******************************************************************************
+** Cast the item so that it will be moved rather than copied, if the compiler
+** supports move semantics.
+*/
+
+#ifdef LEGACY_HAS_CXX11
+
+template<class T>
+inline T&& MoveItem(T& Item)
+{
+	return static_cast<T&&>(Item);
+}
+
+#else
+
+template<class T>
+inline T& MoveItem(T& Item)
+{
+	return Item;
+}
+
+#endif
+
+#endif // TYPETRAITS_HPP